@@ -0,0 +1,50 @@
+#ifndef BENCHMARKUTIL_HPP
+#define BENCHMARKUTIL_HPP
+
+#include "Address.hpp"
+#include "DeliveryRequest.hpp"
+#include <chrono>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Seconds elapsed since a given time point.
+ *
+ * @param start The time point, taken from std::chrono::steady_clock.
+ * @return The elapsed time in seconds.
+ */
+inline double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Generate orders shaped like the large dataset, scaled by a factor.
+ *
+ * 360 days on a 4 x 4 area: 8 regular and 1 Prime order per day, 20 and 4 on the last
+ * 30 days, each times the scale. The generator is seeded, so every call with the same
+ * scale returns the same orders.
+ *
+ * @param scale Multiplier for the number of orders per day.
+ * @return The generated delivery requests.
+ */
+inline std::vector<DeliveryRequest<double>> generateDeliveries(int scale) {
+    std::mt19937 rng(562);
+    std::uniform_int_distribution<int> coordinate(0, 40);
+    std::vector<DeliveryRequest<double>> deliveries;
+
+    for (int day = 1; day <= 360; ++day) {
+        int regular = (day <= 330 ? 8 : 20) * scale;
+        int prime = (day <= 330 ? 1 : 4) * scale;
+        for (int i = 0; i < regular; ++i) {
+            Address<double> customer(coordinate(rng) / 10.0, coordinate(rng) / 10.0);
+            deliveries.emplace_back(customer, day, day + 3, day + 7);
+        }
+        for (int i = 0; i < prime; ++i) {
+            Address<double> customer(coordinate(rng) / 10.0, coordinate(rng) / 10.0);
+            deliveries.emplace_back(customer, day, day + 1, day + 1, true);
+        }
+    }
+    return deliveries;
+}
+
+#endif // BENCHMARKUTIL_HPP
@@ -0,0 +1,328 @@
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <limits>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @class ContractionHierarchy
+ * @brief Shortest-path index over an undirected weighted graph.
+ *
+ * Nodes are contracted one at a time in order of importance; shortcuts keep the
+ * distances between the remaining nodes intact. Queries then only relax edges that
+ * lead to more important nodes, which keeps the search spaces small.
+ */
+class ContractionHierarchy {
+public:
+    /**
+     * @struct Edge
+     * @brief A weighted edge to another node.
+     */
+    struct Edge {
+        int to; ///< Target node
+        double weight; ///< Travel cost of the edge
+    };
+
+    /// Settled (node, distance) pairs of an upward search
+    using SearchSpace = std::vector<std::pair<int, double>>;
+
+private:
+    int numNodes = 0; ///< Number of nodes in the graph
+    std::vector<std::vector<Edge>> graph; ///< Original edges plus shortcuts
+    std::vector<std::vector<Edge>> upward; ///< Edges leading to higher-ranked nodes
+    std::vector<int> rank; ///< Contraction order of every node
+    int witnessSettleLimit = 500; ///< Settled-node limit for witness searches
+    size_t numShortcuts = 0; ///< Number of shortcuts added by the last build
+    mutable std::vector<double> witnessDist; ///< Scratch distances of the witness search
+    mutable std::vector<int> witnessTouched; ///< Nodes with a finite scratch distance
+
+    /**
+     * @brief Add an undirected edge, keeping only the cheapest parallel edge.
+     */
+    void addOrRelaxEdge(int u, int v, double weight) {
+        auto relax = [weight](std::vector<Edge>& edges, int to) {
+            for (auto& edge : edges) {
+                if (edge.to == to) {
+                    edge.weight = std::min(edge.weight, weight);
+                    return;
+                }
+            }
+            edges.push_back({to, weight});
+        };
+        relax(graph[u], v);
+        relax(graph[v], u);
+    }
+
+    /**
+     * @brief Limited Dijkstra among uncontracted nodes that avoids one node.
+     *
+     * Distances are left in witnessDist for the nodes listed in witnessTouched.
+     */
+    void witnessSearch(int source, int avoid, double maxDistance, const std::vector<bool>& contracted) const {
+        for (int node : witnessTouched) witnessDist[node] = std::numeric_limits<double>::infinity();
+        witnessTouched.clear();
+
+        using Item = std::pair<double, int>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+        witnessDist[source] = 0.0;
+        witnessTouched.push_back(source);
+        queue.push({0.0, source});
+        int settled = 0;
+
+        while (!queue.empty() && settled < witnessSettleLimit) {
+            auto [d, u] = queue.top();
+            queue.pop();
+            if (d > witnessDist[u]) continue;
+            if (d > maxDistance) break;
+            ++settled;
+
+            for (const auto& edge : graph[u]) {
+                if (edge.to == avoid || contracted[edge.to]) continue;
+                double candidate = d + edge.weight;
+                if (candidate < witnessDist[edge.to]) {
+                    if (std::isinf(witnessDist[edge.to])) witnessTouched.push_back(edge.to);
+                    witnessDist[edge.to] = candidate;
+                    queue.push({candidate, edge.to});
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Shortcuts needed to contract a node, without modifying the graph.
+     */
+    std::vector<std::pair<std::pair<int, int>, double>> requiredShortcuts(int v, const std::vector<bool>& contracted) const {
+        std::vector<Edge> neighbors;
+        for (const auto& edge : graph[v]) {
+            if (!contracted[edge.to]) neighbors.push_back(edge);
+        }
+
+        double maxOut = 0.0;
+        for (const auto& edge : neighbors) maxOut = std::max(maxOut, edge.weight);
+
+        std::vector<std::pair<std::pair<int, int>, double>> shortcuts;
+        for (size_t i = 0; i < neighbors.size(); ++i) {
+            const Edge& in = neighbors[i];
+            witnessSearch(in.to, v, in.weight + maxOut, contracted);
+
+            for (size_t j = i + 1; j < neighbors.size(); ++j) {
+                const Edge& out = neighbors[j];
+                double viaV = in.weight + out.weight;
+                if (witnessDist[out.to] > viaV) {
+                    shortcuts.push_back({{in.to, out.to}, viaV});
+                }
+            }
+        }
+        return shortcuts;
+    }
+
+    /**
+     * @brief Contraction priority: edge difference plus already contracted neighbors.
+     */
+    int priority(int v, const std::vector<bool>& contracted, const std::vector<int>& contractedNeighbors) const {
+        int degree = 0;
+        for (const auto& edge : graph[v]) {
+            if (!contracted[edge.to]) ++degree;
+        }
+        int shortcuts = static_cast<int>(requiredShortcuts(v, contracted).size());
+        return shortcuts - degree + contractedNeighbors[v];
+    }
+
+public:
+    /**
+     * @brief Constructor for an empty graph with the given number of nodes.
+     *
+     * @param nodes The number of nodes.
+     */
+    explicit ContractionHierarchy(int nodes = 0) : numNodes(nodes), graph(nodes) {}
+
+    /**
+     * @brief Add an undirected edge to the graph. Call before build().
+     *
+     * @param u One end of the edge.
+     * @param v The other end of the edge.
+     * @param weight The travel cost of the edge.
+     */
+    void addEdge(int u, int v, double weight) {
+        if (u == v) return;
+        addOrRelaxEdge(u, v, weight);
+    }
+
+    /**
+     * @brief Contract all nodes and build the upward search graph.
+     */
+    void build() {
+        std::vector<bool> contracted(numNodes, false);
+        std::vector<int> contractedNeighbors(numNodes, 0);
+        rank.assign(numNodes, 0);
+        numShortcuts = 0;
+        witnessDist.assign(numNodes, std::numeric_limits<double>::infinity());
+        witnessTouched.clear();
+
+        using Item = std::pair<int, int>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+        for (int v = 0; v < numNodes; ++v) {
+            queue.push({priority(v, contracted, contractedNeighbors), v});
+        }
+
+        int nextRank = 0;
+        while (!queue.empty()) {
+            auto [p, v] = queue.top();
+            queue.pop();
+            if (contracted[v]) continue;
+
+            // Lazy update: re-evaluate and postpone if the node is no longer the cheapest
+            int current = priority(v, contracted, contractedNeighbors);
+            if (!queue.empty() && current > queue.top().first) {
+                queue.push({current, v});
+                continue;
+            }
+
+            for (const auto& [ends, weight] : requiredShortcuts(v, contracted)) {
+                addOrRelaxEdge(ends.first, ends.second, weight);
+                ++numShortcuts;
+            }
+            contracted[v] = true;
+            rank[v] = nextRank++;
+            for (const auto& edge : graph[v]) {
+                ++contractedNeighbors[edge.to];
+            }
+        }
+
+        upward.assign(numNodes, {});
+        for (int v = 0; v < numNodes; ++v) {
+            for (const auto& edge : graph[v]) {
+                if (rank[edge.to] > rank[v]) upward[v].push_back(edge);
+            }
+        }
+    }
+
+    /**
+     * @brief Dijkstra over upward edges only.
+     *
+     * @param source The start node.
+     * @return All settled nodes with their upward distance from the source.
+     */
+    SearchSpace upwardSearch(int source) const {
+        thread_local std::vector<double> dist;
+        thread_local std::vector<int> touched;
+        if (dist.size() < static_cast<size_t>(numNodes)) {
+            dist.assign(numNodes, std::numeric_limits<double>::infinity());
+        }
+
+        using Item = std::pair<double, int>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+        SearchSpace settled;
+        dist[source] = 0.0;
+        touched.push_back(source);
+        queue.push({0.0, source});
+
+        while (!queue.empty()) {
+            auto [d, u] = queue.top();
+            queue.pop();
+            if (d > dist[u]) continue;
+
+            // Stall-on-demand: a higher-ranked neighbor already reaches u more cheaply
+            bool stalled = false;
+            for (const auto& edge : upward[u]) {
+                if (dist[edge.to] + edge.weight < d) {
+                    stalled = true;
+                    break;
+                }
+            }
+            if (stalled) continue;
+            settled.push_back({u, d});
+
+            for (const auto& edge : upward[u]) {
+                double candidate = d + edge.weight;
+                if (candidate < dist[edge.to]) {
+                    if (std::isinf(dist[edge.to])) touched.push_back(edge.to);
+                    dist[edge.to] = candidate;
+                    queue.push({candidate, edge.to});
+                }
+            }
+        }
+
+        for (int node : touched) dist[node] = std::numeric_limits<double>::infinity();
+        touched.clear();
+        return settled;
+    }
+
+    /**
+     * @brief Shortest-path distance between two nodes.
+     *
+     * @param source The start node.
+     * @param target The destination node.
+     * @return The distance, or infinity if the nodes are not connected.
+     */
+    double query(int source, int target) const {
+        if (source == target) return 0.0;
+        thread_local std::vector<double> meeting;
+        if (meeting.size() < static_cast<size_t>(numNodes)) {
+            meeting.assign(numNodes, std::numeric_limits<double>::infinity());
+        }
+
+        SearchSpace forward = upwardSearch(source);
+        SearchSpace backward = upwardSearch(target);
+        for (const auto& [node, d] : forward) meeting[node] = d;
+
+        double best = std::numeric_limits<double>::infinity();
+        for (const auto& [node, d] : backward) {
+            best = std::min(best, meeting[node] + d);
+        }
+
+        for (const auto& [node, d] : forward) meeting[node] = std::numeric_limits<double>::infinity();
+        return best;
+    }
+
+    /**
+     * @brief Distances between every source and every target node (bucket-based).
+     *
+     * @param sources The start nodes.
+     * @param targets The destination nodes.
+     * @return A matrix where entry [i][j] is the distance from sources[i] to targets[j].
+     */
+    std::vector<std::vector<double>> manyToMany(const std::vector<int>& sources, const std::vector<int>& targets) const {
+        std::unordered_map<int, std::vector<std::pair<size_t, double>>> buckets;
+        for (size_t j = 0; j < targets.size(); ++j) {
+            for (const auto& [node, d] : upwardSearch(targets[j])) {
+                buckets[node].push_back({j, d});
+            }
+        }
+
+        std::vector<std::vector<double>> matrix(
+            sources.size(), std::vector<double>(targets.size(), std::numeric_limits<double>::infinity()));
+        for (size_t i = 0; i < sources.size(); ++i) {
+            for (const auto& [node, d] : upwardSearch(sources[i])) {
+                auto it = buckets.find(node);
+                if (it == buckets.end()) continue;
+                for (const auto& [j, dTarget] : it->second) {
+                    matrix[i][j] = std::min(matrix[i][j], d + dTarget);
+                }
+            }
+        }
+        return matrix;
+    }
+
+    /**
+     * @brief Get the number of nodes in the graph.
+     *
+     * @return The number of nodes.
+     */
+    int getNumNodes() const { return numNodes; }
+
+    /**
+     * @brief Get the number of shortcuts added by the last build.
+     *
+     * @return The number of shortcuts.
+     */
+    size_t getNumShortcuts() const { return numShortcuts; }
+};
+
+#endif // CONTRACTIONHIERARCHY_HPP
@@ -0,0 +1,72 @@
+#ifndef DELIVERYLOADER_HPP
+#define DELIVERYLOADER_HPP
+
+#include "DeliveryRequest.hpp"
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+/**
+ * @brief Helper function to load delivery requests from a CSV file.
+ * 
+ * @param filename The name of the input CSV file.
+ * @param regularDeliveries A vector to store regular delivery requests.
+ * @param primeDeliveries A vector to store Prime delivery requests.
+ */
+inline void loadDeliveriesFromCSV(
+    const std::string& filename,
+    std::vector<DeliveryRequest<double>>& regularDeliveries,
+    std::vector<DeliveryRequest<double>>& primeDeliveries) {
+    std::ifstream inFile(filename);
+    if (!inFile.is_open()) {
+        std::cerr << "Error opening input file: " << filename << std::endl;
+        return;
+    }
+
+    std::string line;
+    // Skip the header
+    std::getline(inFile, line);
+
+    while (std::getline(inFile, line)) {
+        std::istringstream ss(line);
+        std::string value;
+        double x, y;
+        int placementDate, earliest, latest;
+        bool isPrime;
+
+        // Parse values from the CSV
+        std::getline(ss, value, ',');
+        x = std::stod(value);
+
+        std::getline(ss, value, ',');
+        y = std::stod(value);
+
+        std::getline(ss, value, ',');
+        placementDate = std::stoi(value);
+
+        std::getline(ss, value, ',');
+        earliest = std::stoi(value);
+
+        std::getline(ss, value, ',');
+        latest = std::stoi(value);
+
+        std::getline(ss, value, ',');
+        isPrime = (value == "1");
+
+        Address<double> customer(x, y);
+        DeliveryRequest<double> delivery(customer, placementDate, earliest, latest, isPrime);
+
+        // Separate into regular and Prime deliveries
+        if (isPrime) {
+            primeDeliveries.push_back(delivery);
+        } else {
+            regularDeliveries.push_back(delivery);
+        }
+    }
+
+    inFile.close();
+}
+
+#endif // DELIVERYLOADER_HPP
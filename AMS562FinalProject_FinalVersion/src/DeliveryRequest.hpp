@@ -67,6 +67,13 @@ public:
      */
     int getLatestDeliveryDate() const { return latestDeliveryDate; }
 
+    /**
+     * @brief Check whether the delivery is for a Prime customer.
+     * 
+     * @return True if the delivery is a Prime delivery, false otherwise.
+     */
+    bool getIsPrime() const { return isPrime; }
+
     /**
      * @brief Check if a given day is within the delivery window.
      * 
@@ -0,0 +1,90 @@
+#ifndef MPSCQUEUE_HPP
+#define MPSCQUEUE_HPP
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+/**
+ * @class MpscQueue
+ * @brief Unbounded lock-free queue for many producers and a single consumer.
+ *
+ * Producers link a new node with one atomic exchange, so push never blocks or retries.
+ * The consumer owns the tail and walks the links; the node it last consumed stays
+ * behind as the dummy that producers link to. Items from one producer are popped in
+ * the order they were pushed.
+ *
+ * @tparam Item The type of the queued items.
+ */
+template <typename Item>
+class MpscQueue {
+private:
+    /**
+     * @struct Node
+     * @brief A linked queue node; the dummy node holds no item.
+     */
+    struct Node {
+        std::atomic<Node*> next{nullptr}; ///< Next node, set by the producer that pushed it
+        std::optional<Item> item; ///< The queued item
+    };
+
+    std::atomic<Node*> head; ///< Most recently pushed node (producers)
+    Node* tail; ///< Dummy node before the oldest item (consumer only)
+
+public:
+    MpscQueue() : head(new Node), tail(head.load(std::memory_order_relaxed)) {}
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    ~MpscQueue() {
+        while (tail) {
+            Node* next = tail->next.load(std::memory_order_relaxed);
+            delete tail;
+            tail = next;
+        }
+    }
+
+    /**
+     * @brief Add an item. Safe to call from any number of threads.
+     *
+     * @param item The item to add.
+     */
+    void push(Item item) {
+        Node* node = new Node;
+        node->item.emplace(std::move(item));
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Check whether an item is ready to pop. Only the consumer thread may call this.
+     *
+     * @return True if pop would fail right now.
+     */
+    bool empty() const {
+        return tail->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+    /**
+     * @brief Take the oldest item. Only one thread may call this.
+     *
+     * An item whose producer is between its exchange and its link is not visible yet;
+     * pop then reports an empty queue and the item appears on a later call.
+     *
+     * @param item Receives the item.
+     * @return True if an item was taken.
+     */
+    bool pop(Item& item) {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) return false;
+
+        item = std::move(*next->item);
+        next->item.reset();
+        delete tail;
+        tail = next;
+        return true;
+    }
+};
+
+#endif // MPSCQUEUE_HPP
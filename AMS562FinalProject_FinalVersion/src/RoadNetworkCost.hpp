@@ -0,0 +1,468 @@
+#ifndef ROADNETWORKCOST_HPP
+#define ROADNETWORKCOST_HPP
+
+#include "TravelCost.hpp"
+#include "ContractionHierarchy.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class RoadNetworkCost
+ * @brief Travel costs along a local road graph, answered by a contraction hierarchy.
+ *
+ * Addresses are snapped to their nearest graph node; the cost of a leg is the
+ * straight-line distance to and from the snapped nodes plus the shortest road path
+ * between them. Node-pair costs are cached since optimizers evaluate the same legs
+ * many times; the caches are split into independently locked shards so that zone
+ * worker threads rarely wait on each other. Edges are treated as two-way.
+ *
+ * @tparam T The type of the coordinates in the Address (e.g., int, float, double).
+ */
+template <typename T>
+class RoadNetworkCost : public TravelCostModel<T> {
+private:
+    std::vector<double> nodeX; ///< X-coordinate of every node
+    std::vector<double> nodeY; ///< Y-coordinate of every node
+    std::vector<std::pair<std::pair<int, int>, double>> edges; ///< Edge list as loaded
+    ContractionHierarchy hierarchy; ///< Shortest-path index over the graph
+
+    double minX = 0.0, minY = 0.0; ///< Lower corner of the snapping grid
+    double cellSize = 1.0; ///< Side length of a snapping grid cell
+    int gridWidth = 1, gridHeight = 1; ///< Number of snapping grid cells per axis
+    std::vector<std::vector<int>> grid; ///< Nodes in every snapping grid cell
+
+    /**
+     * @struct PointHash
+     * @brief Hash of an address' coordinates for the snap cache.
+     */
+    struct PointHash {
+        size_t operator()(const std::pair<double, double>& point) const {
+            return std::hash<double>()(point.first) * 31 + std::hash<double>()(point.second);
+        }
+    };
+
+    /**
+     * @struct CacheShard
+     * @brief One independently locked part of the path and snap caches.
+     */
+    struct CacheShard {
+        std::mutex mutex; ///< Guards the maps of this shard
+        std::unordered_map<uint64_t, double> paths; ///< Node-pair path costs
+        std::unordered_map<std::pair<double, double>, std::pair<int, double>, PointHash> snaps; ///< Snapped node and offset per address
+    };
+
+    static constexpr size_t numShards = 16; ///< Number of cache shards
+    mutable std::array<CacheShard, numShards> shards; ///< Path and snap caches
+    mutable std::atomic<size_t> cacheHits{0}; ///< Number of path costs answered from the cache
+    mutable std::atomic<size_t> cacheMisses{0}; ///< Number of path costs computed by the hierarchy
+
+    static uint64_t pairKey(int a, int b) {
+        if (a > b) std::swap(a, b);
+        return (static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint32_t>(b);
+    }
+
+    static CacheShard& shardOf(std::array<CacheShard, numShards>& caches, size_t hash) {
+        return caches[(hash ^ (hash >> 17) ^ (hash >> 33)) % numShards];
+    }
+
+    bool edgesValid() const {
+        int numNodes = static_cast<int>(nodeX.size());
+        for (const auto& [ends, cost] : edges) {
+            if (ends.first < 0 || ends.second < 0 || ends.first >= numNodes || ends.second >= numNodes || cost < 0.0) {
+                std::cerr << "Invalid road graph edge: " << ends.first << " -> " << ends.second << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int cellIndex(int cx, int cy) const { return cy * gridWidth + cx; }
+
+    /**
+     * @brief Bucket all nodes into a uniform grid for nearest-node lookups.
+     */
+    void buildSnapGrid() {
+        if (nodeX.empty()) return;
+        double maxX = nodeX[0], maxY = nodeY[0];
+        minX = nodeX[0];
+        minY = nodeY[0];
+        for (size_t i = 1; i < nodeX.size(); ++i) {
+            minX = std::min(minX, nodeX[i]);
+            minY = std::min(minY, nodeY[i]);
+            maxX = std::max(maxX, nodeX[i]);
+            maxY = std::max(maxY, nodeY[i]);
+        }
+
+        // About sqrt(N) cells along the longer side, so degenerate (e.g. collinear) graphs stay small
+        double longestSide = std::max(maxX - minX, maxY - minY);
+        cellSize = longestSide > 0.0 ? longestSide / std::ceil(std::sqrt(static_cast<double>(nodeX.size()))) : 1.0;
+        gridWidth = static_cast<int>((maxX - minX) / cellSize) + 1;
+        gridHeight = static_cast<int>((maxY - minY) / cellSize) + 1;
+        grid.assign(static_cast<size_t>(gridWidth) * gridHeight, {});
+
+        for (size_t i = 0; i < nodeX.size(); ++i) {
+            int cx = static_cast<int>((nodeX[i] - minX) / cellSize);
+            int cy = static_cast<int>((nodeY[i] - minY) / cellSize);
+            grid[cellIndex(cx, cy)].push_back(static_cast<int>(i));
+        }
+    }
+
+    /**
+     * @brief Nearest node by searching grid rings outward from the address' cell.
+     */
+    std::pair<int, double> nearestNode(double x, double y) const {
+        int cx = std::clamp(static_cast<int>(std::floor((x - minX) / cellSize)), 0, gridWidth - 1);
+        int cy = std::clamp(static_cast<int>(std::floor((y - minY) / cellSize)), 0, gridHeight - 1);
+        int best = -1;
+        double bestDistance = std::numeric_limits<double>::infinity();
+        int maxRing = std::max(gridWidth, gridHeight);
+
+        for (int ring = 0; ring <= maxRing; ++ring) {
+            for (int gy = cy - ring; gy <= cy + ring; ++gy) {
+                for (int gx = cx - ring; gx <= cx + ring; ++gx) {
+                    if (gx < 0 || gy < 0 || gx >= gridWidth || gy >= gridHeight) continue;
+                    if (std::max(std::abs(gx - cx), std::abs(gy - cy)) != ring) continue;
+                    for (int node : grid[cellIndex(gx, gy)]) {
+                        double d = std::hypot(nodeX[node] - x, nodeY[node] - y);
+                        if (d < bestDistance) {
+                            bestDistance = d;
+                            best = node;
+                        }
+                    }
+                }
+            }
+            // Every node in a further ring is at least ring * cellSize away
+            if (best != -1 && bestDistance <= ring * cellSize) break;
+        }
+        return {best, bestDistance};
+    }
+
+    /**
+     * @brief Path cost between two nodes, answered from the cache when possible.
+     */
+    double pathCost(int a, int b) const {
+        if (a == b) return 0.0;
+        uint64_t key = pairKey(a, b);
+        CacheShard& shard = shardOf(shards, std::hash<uint64_t>()(key));
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.paths.find(key);
+            if (it != shard.paths.end()) {
+                cacheHits.fetch_add(1, std::memory_order_relaxed);
+                return it->second;
+            }
+        }
+        double d = hierarchy.query(a, b);
+        cacheMisses.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.paths[key] = d;
+        return d;
+    }
+
+public:
+    /**
+     * @brief Load the road graph from node and edge CSV files.
+     *
+     * The node file has the header `Id,X,Y` with ids 0..N-1; the edge file has the
+     * header `From,To,Cost`.
+     *
+     * @param nodesFile The name of the node CSV file.
+     * @param edgesFile The name of the edge CSV file.
+     * @return True on success, false if a file could not be read.
+     */
+    bool loadFromCSV(const std::string& nodesFile, const std::string& edgesFile) {
+        std::ifstream nodesIn(nodesFile);
+        std::ifstream edgesIn(edgesFile);
+        if (!nodesIn.is_open() || !edgesIn.is_open()) {
+            std::cerr << "Error opening road graph files: " << nodesFile << ", " << edgesFile << std::endl;
+            return false;
+        }
+
+        std::vector<std::pair<int, std::pair<double, double>>> nodes;
+        std::string line;
+        std::getline(nodesIn, line); // Skip the header
+        while (std::getline(nodesIn, line)) {
+            if (line.empty()) continue;
+            std::istringstream ss(line);
+            std::string id, x, y;
+            std::getline(ss, id, ',');
+            std::getline(ss, x, ',');
+            std::getline(ss, y, ',');
+            nodes.push_back({std::stoi(id), {std::stod(x), std::stod(y)}});
+        }
+
+        nodeX.assign(nodes.size(), 0.0);
+        nodeY.assign(nodes.size(), 0.0);
+        for (const auto& [id, coordinates] : nodes) {
+            if (id < 0 || id >= static_cast<int>(nodes.size())) {
+                std::cerr << "Invalid node id in road graph: " << id << std::endl;
+                return false;
+            }
+            nodeX[id] = coordinates.first;
+            nodeY[id] = coordinates.second;
+        }
+
+        edges.clear();
+        std::getline(edgesIn, line); // Skip the header
+        while (std::getline(edgesIn, line)) {
+            if (line.empty()) continue;
+            std::istringstream ss(line);
+            std::string from, to, cost;
+            std::getline(ss, from, ',');
+            std::getline(ss, to, ',');
+            std::getline(ss, cost, ',');
+            edges.push_back({{std::stoi(from), std::stoi(to)}, std::stod(cost)});
+        }
+
+        if (!edgesValid()) return false;
+        build();
+        return true;
+    }
+
+    /**
+     * @brief Load the road graph from the binary format written by saveBinary().
+     *
+     * @param filename The name of the binary graph file.
+     * @return True on success, false if the file could not be read.
+     */
+    bool loadFromBinary(const std::string& filename) {
+        std::ifstream in(filename, std::ios::binary);
+        char magic[4];
+        if (!in.is_open() || !in.read(magic, 4) || std::string(magic, 4) != "RNG1") {
+            std::cerr << "Error opening road graph file: " << filename << std::endl;
+            return false;
+        }
+
+        uint32_t numNodes = 0, numEdges = 0;
+        in.read(reinterpret_cast<char*>(&numNodes), sizeof(numNodes));
+        in.read(reinterpret_cast<char*>(&numEdges), sizeof(numEdges));
+        nodeX.assign(numNodes, 0.0);
+        nodeY.assign(numNodes, 0.0);
+        for (uint32_t i = 0; i < numNodes; ++i) {
+            in.read(reinterpret_cast<char*>(&nodeX[i]), sizeof(double));
+            in.read(reinterpret_cast<char*>(&nodeY[i]), sizeof(double));
+        }
+
+        edges.assign(numEdges, {{0, 0}, 0.0});
+        for (uint32_t i = 0; i < numEdges; ++i) {
+            uint32_t from = 0, to = 0;
+            in.read(reinterpret_cast<char*>(&from), sizeof(from));
+            in.read(reinterpret_cast<char*>(&to), sizeof(to));
+            in.read(reinterpret_cast<char*>(&edges[i].second), sizeof(double));
+            edges[i].first = {static_cast<int>(from), static_cast<int>(to)};
+        }
+
+        if (!in) {
+            std::cerr << "Truncated road graph file: " << filename << std::endl;
+            return false;
+        }
+        if (!edgesValid()) return false;
+        build();
+        return true;
+    }
+
+    /**
+     * @brief Save the road graph in a compact binary format.
+     *
+     * @param filename The name of the output file.
+     * @return True on success, false if the file could not be written.
+     */
+    bool saveBinary(const std::string& filename) const {
+        std::ofstream out(filename, std::ios::binary);
+        if (!out.is_open()) {
+            std::cerr << "Error opening file for export.\n";
+            return false;
+        }
+
+        uint32_t numNodes = static_cast<uint32_t>(nodeX.size());
+        uint32_t numEdges = static_cast<uint32_t>(edges.size());
+        out.write("RNG1", 4);
+        out.write(reinterpret_cast<const char*>(&numNodes), sizeof(numNodes));
+        out.write(reinterpret_cast<const char*>(&numEdges), sizeof(numEdges));
+        for (uint32_t i = 0; i < numNodes; ++i) {
+            out.write(reinterpret_cast<const char*>(&nodeX[i]), sizeof(double));
+            out.write(reinterpret_cast<const char*>(&nodeY[i]), sizeof(double));
+        }
+        for (const auto& [ends, cost] : edges) {
+            uint32_t from = static_cast<uint32_t>(ends.first);
+            uint32_t to = static_cast<uint32_t>(ends.second);
+            out.write(reinterpret_cast<const char*>(&from), sizeof(from));
+            out.write(reinterpret_cast<const char*>(&to), sizeof(to));
+            out.write(reinterpret_cast<const char*>(&cost), sizeof(double));
+        }
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * @brief Add a node to the graph. Call build() after all nodes and edges are added.
+     *
+     * @param x The X-coordinate of the node.
+     * @param y The Y-coordinate of the node.
+     * @return The id of the new node.
+     */
+    int addNode(double x, double y) {
+        nodeX.push_back(x);
+        nodeY.push_back(y);
+        return static_cast<int>(nodeX.size()) - 1;
+    }
+
+    /**
+     * @brief Add a two-way road between two nodes.
+     *
+     * @param from One end of the road.
+     * @param to The other end of the road.
+     * @param cost The travel cost of the road.
+     */
+    void addEdge(int from, int to, double cost) {
+        edges.push_back({{from, to}, cost});
+    }
+
+    /**
+     * @brief Preprocess the graph: build the snapping grid and the contraction hierarchy.
+     */
+    void build() {
+        hierarchy = ContractionHierarchy(static_cast<int>(nodeX.size()));
+        for (const auto& [ends, cost] : edges) {
+            hierarchy.addEdge(ends.first, ends.second, cost);
+        }
+        hierarchy.build();
+        buildSnapGrid();
+
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.paths.clear();
+            shard.snaps.clear();
+        }
+        cacheHits = 0;
+        cacheMisses = 0;
+        this->invalidateCosts();
+    }
+
+    /**
+     * @brief Snap an address to its nearest graph node.
+     *
+     * @param address The address to snap.
+     * @return The nearest node and the straight-line distance to it.
+     */
+    std::pair<int, double> snap(const Address<T>& address) const {
+        std::pair<double, double> key(static_cast<double>(address.getX()), static_cast<double>(address.getY()));
+        CacheShard& shard = shardOf(shards, PointHash()(key));
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.snaps.find(key);
+            if (it != shard.snaps.end()) return it->second;
+        }
+        auto snapped = nearestNode(key.first, key.second);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.snaps[key] = snapped;
+        return snapped;
+    }
+
+    /**
+     * @brief Road travel cost between two addresses.
+     *
+     * Addresses whose snapped nodes are not connected fall back to the straight-line
+     * distance so that optimizers always see a finite cost.
+     *
+     * @param from The start address.
+     * @param to The destination address.
+     * @return The travel cost.
+     */
+    double cost(const Address<T>& from, const Address<T>& to) const override {
+        if (from.getX() == to.getX() && from.getY() == to.getY()) return 0.0;
+        if (nodeX.empty()) return from.distanceTo(to);
+
+        auto [a, offsetA] = snap(from);
+        auto [b, offsetB] = snap(to);
+        double path = pathCost(a, b);
+        if (!std::isfinite(path)) return from.distanceTo(to);
+        return offsetA + path + offsetB;
+    }
+
+    /**
+     * @brief Road travel costs between every source and every target.
+     *
+     * Uses a single bucket-based many-to-many hierarchy query and fills the cache.
+     */
+    std::vector<std::vector<double>> costMatrix(const std::vector<Address<T>>& sources,
+                                                const std::vector<Address<T>>& targets) const override {
+        if (nodeX.empty()) return TravelCostModel<T>::costMatrix(sources, targets);
+
+        std::vector<std::pair<int, double>> sourceNodes, targetNodes;
+        std::vector<int> sourceIds, targetIds;
+        for (const auto& address : sources) {
+            sourceNodes.push_back(snap(address));
+            sourceIds.push_back(sourceNodes.back().first);
+        }
+        for (const auto& address : targets) {
+            targetNodes.push_back(snap(address));
+            targetIds.push_back(targetNodes.back().first);
+        }
+
+        auto paths = hierarchy.manyToMany(sourceIds, targetIds);
+        std::vector<std::vector<double>> matrix(sources.size(), std::vector<double>(targets.size(), 0.0));
+        for (size_t i = 0; i < sources.size(); ++i) {
+            for (size_t j = 0; j < targets.size(); ++j) {
+                uint64_t key = pairKey(sourceIds[i], targetIds[j]);
+                CacheShard& shard = shardOf(shards, std::hash<uint64_t>()(key));
+                {
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    shard.paths[key] = paths[i][j];
+                }
+                if (sources[i].getX() == targets[j].getX() && sources[i].getY() == targets[j].getY()) {
+                    matrix[i][j] = 0.0;
+                } else if (!std::isfinite(paths[i][j])) {
+                    matrix[i][j] = sources[i].distanceTo(targets[j]);
+                } else {
+                    matrix[i][j] = sourceNodes[i].second + paths[i][j] + targetNodes[j].second;
+                }
+            }
+        }
+        return matrix;
+    }
+
+    /**
+     * @brief Get the number of nodes in the road graph.
+     *
+     * @return The number of nodes.
+     */
+    int getNumNodes() const { return static_cast<int>(nodeX.size()); }
+
+    /**
+     * @brief Get the contraction hierarchy built over the road graph.
+     *
+     * @return The contraction hierarchy.
+     */
+    const ContractionHierarchy& getHierarchy() const { return hierarchy; }
+
+    /**
+     * @brief Get the number of path costs answered from the cache.
+     *
+     * @return The number of cache hits.
+     */
+    size_t getCacheHits() const {
+        return cacheHits.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of path costs computed by the hierarchy.
+     *
+     * @return The number of cache misses.
+     */
+    size_t getCacheMisses() const {
+        return cacheMisses.load(std::memory_order_relaxed);
+    }
+};
+
+#endif // ROADNETWORKCOST_HPP
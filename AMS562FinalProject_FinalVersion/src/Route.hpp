@@ -2,82 +2,354 @@
 #define ROUTE_HPP
 
 #include "DeliveryRequest.hpp"
+#include "TravelCost.hpp"
+#include "TourSolver.hpp"
 #include <vector>
+#include <utility>
+#include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <limits>
 
 /**
  * @class Route
  * @brief Represents a delivery route for a single day, with templated DeliveryRequest.
  * 
+ * Orders at the same location are consolidated into one stop, so distances are evaluated
+ * per stop rather than per order. Each order keeps its own delivery window, and the
+ * order-level accessors expand the stops back into orders. Every change gives the route a
+ * new process-wide unique revision, so copies of it can be reused until it changes.
+ * 
  * @tparam T The type of the coordinates in the Address (e.g., int, float, double).
  */
 template <typename T>
 class Route {
+public:
+    /**
+     * @struct Stop
+     * @brief A location visited once, serving one or more orders.
+     */
+    struct Stop {
+        Address<T> location; ///< Where the vehicle stops (the first order's address)
+        std::vector<DeliveryRequest<T>> orders; ///< Orders served at this stop
+        std::pair<double, double> key; ///< Location key that merging orders must match
+    };
+
 private:
-    std::vector<DeliveryRequest<T>> deliveries; ///< List of delivery requests for the route
+    std::vector<Stop> stops; ///< Stops in visiting order
+    size_t numOrders = 0; ///< Number of orders across all stops
+    double mergeTolerance = 0.0; ///< Grid size within which addresses share a stop (0: identical only, negative: never)
+    uint64_t revision = nextRevision(); ///< Identifies the current contents of the route
+
+    static uint64_t nextRevision() {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    std::pair<double, double> locationKey(const Address<T>& address) const {
+        double x = static_cast<double>(address.getX()), y = static_cast<double>(address.getY());
+        if (mergeTolerance <= 0.0) return {x, y};
+        return {std::round(x / mergeTolerance), std::round(y / mergeTolerance)};
+    }
+
+    /**
+     * @brief Index of the stop an address would be merged into, or stops.size() if none.
+     */
+    size_t findStop(const Address<T>& address) const {
+        if (mergeTolerance < 0.0) return stops.size();
+        const std::pair<double, double> key = locationKey(address);
+        for (size_t i = 0; i < stops.size(); ++i) {
+            if (stops[i].key == key) return i;
+        }
+        return stops.size();
+    }
+
+    /**
+     * @brief Index of the last stop serving a delivery, or stops.size() if none.
+     */
+    size_t findOrder(const DeliveryRequest<T>& delivery) const {
+        for (size_t i = stops.size(); i-- > 0;) {
+            const auto& orders = stops[i].orders;
+            if (std::find(orders.begin(), orders.end(), delivery) != orders.end()) return i;
+        }
+        return stops.size();
+    }
 
 public:
+    /**
+     * @brief Constructor for an empty route.
+     * 
+     * @param tolerance Grid size within which addresses share a stop (0 merges identical addresses
+     *                  only, a negative value disables merging).
+     */
+    explicit Route(double tolerance = 0.0) : mergeTolerance(tolerance) {}
+
     /**
      * @brief Add a delivery request to the route.
      * 
+     * The order joins an existing stop at the same location, or becomes a new last stop.
+     * 
      * @param delivery The delivery request to add.
      */
     void addDelivery(const DeliveryRequest<T>& delivery) {
-        deliveries.push_back(delivery);
+        insertDelivery(delivery, stops.size());
+    }
+
+    /**
+     * @brief Insert a delivery request at a given stop position in the route.
+     * 
+     * If a stop at the same location exists the order joins it and the position is ignored.
+     * 
+     * @param delivery The delivery request to insert.
+     * @param position The stop index a new stop will occupy (clamped to the number of stops).
+     */
+    void insertDelivery(const DeliveryRequest<T>& delivery, size_t position) {
+        ++numOrders;
+        revision = nextRevision();
+        size_t existing = findStop(delivery.getAddress());
+        if (existing < stops.size()) {
+            stops[existing].orders.push_back(delivery);
+            return;
+        }
+
+        position = std::min(position, stops.size());
+        stops.insert(stops.begin() + position, Stop{delivery.getAddress(), {delivery}, locationKey(delivery.getAddress())});
     }
 
     /**
      * @brief Remove a delivery request from the route.
      * 
+     * Identical requests (same address and dates) are separate orders, so only the last
+     * occurrence is removed; adding and then removing a delivery restores the route.
+     * A stop is dropped once its last order is removed.
+     * 
      * @param delivery The delivery request to remove.
      */
     void removeDelivery(const DeliveryRequest<T>& delivery) {
-        deliveries.erase(std::remove(deliveries.begin(), deliveries.end(), delivery), deliveries.end());
+        size_t i = findOrder(delivery);
+        if (i == stops.size()) return;
+
+        auto& orders = stops[i].orders;
+        orders.erase(std::next(std::find(orders.rbegin(), orders.rend(), delivery)).base());
+        --numOrders;
+        revision = nextRevision();
+
+        if (orders.empty()) stops.erase(stops.begin() + i);
     }
 
     /**
      * @brief Calculate the total distance of the route, starting and ending at the depot.
      * 
      * @param depot The starting and ending location of the route.
+     * @param costModel The travel cost model used for every leg (Euclidean by default).
      * @return The total distance of the route.
      */
-    double totalDistance(const Address<T>& depot) const {
-        if (deliveries.empty()) return 0.0;
+    double totalDistance(const Address<T>& depot,
+                         const TravelCostModel<T>& costModel = defaultTravelCost<T>()) const {
+        if (stops.empty()) return 0.0;
 
         double distance = 0.0;
         Address<T> currentLocation = depot;
 
-        for (const auto& delivery : deliveries) {
-            distance += currentLocation.distanceTo(delivery.getAddress());
-            currentLocation = delivery.getAddress();
+        for (const auto& stop : stops) {
+            distance += costModel.cost(currentLocation, stop.location);
+            currentLocation = stop.location;
         }
 
-        distance += currentLocation.distanceTo(depot); // Return to depot
+        distance += costModel.cost(currentLocation, depot); // Return to depot
         return distance;
     }
 
     /**
-     * @brief Get the list of deliveries in the route.
+     * @brief Cheapest cost of inserting a delivery anywhere in the route.
+     * 
+     * An order at the location of an existing stop joins that stop at no cost.
+     * 
+     * @param delivery The delivery request to insert.
+     * @param depot The starting and ending location of the route.
+     * @param costModel The travel cost model used for every leg (Euclidean by default).
+     * @param position If not null, receives the cheapest insertion position (a stop index).
+     * @return The increase in total distance caused by the insertion.
+     */
+    double insertionCost(const DeliveryRequest<T>& delivery, const Address<T>& depot,
+                         const TravelCostModel<T>& costModel = defaultTravelCost<T>(),
+                         size_t* position = nullptr) const {
+        const Address<T> address = delivery.getAddress();
+        if (stops.empty()) {
+            if (position) *position = 0;
+            return costModel.cost(depot, address) + costModel.cost(address, depot);
+        }
+
+        size_t existing = findStop(address);
+        if (existing < stops.size()) {
+            if (position) *position = existing;
+            return 0.0;
+        }
+
+        double bestCost = std::numeric_limits<double>::infinity();
+        size_t bestPosition = 0;
+        for (size_t i = 0; i <= stops.size(); ++i) {
+            const Address<T> previous = i == 0 ? depot : stops[i - 1].location;
+            const Address<T> next = i == stops.size() ? depot : stops[i].location;
+            double delta = costModel.cost(previous, address) + costModel.cost(address, next) - costModel.cost(previous, next);
+            if (delta < bestCost) {
+                bestCost = delta;
+                bestPosition = i;
+            }
+        }
+
+        if (position) *position = bestPosition;
+        return bestCost;
+    }
+
+    /**
+     * @brief Distance saved by removing a delivery from the route.
+     * 
+     * Removing one of several orders at a stop saves nothing; the stop is still visited.
+     * 
+     * @param delivery The delivery request to remove.
+     * @param depot The starting and ending location of the route.
+     * @param costModel The travel cost model used for every leg (Euclidean by default).
+     * @return The decrease in total distance, or 0 if the delivery is not in the route.
+     */
+    double removalGain(const DeliveryRequest<T>& delivery, const Address<T>& depot,
+                       const TravelCostModel<T>& costModel = defaultTravelCost<T>()) const {
+        size_t i = findOrder(delivery);
+        if (i == stops.size() || stops[i].orders.size() > 1) return 0.0;
+
+        const Address<T> address = stops[i].location;
+        if (stops.size() == 1) return costModel.cost(depot, address) + costModel.cost(address, depot);
+        const Address<T> previous = i == 0 ? depot : stops[i - 1].location;
+        const Address<T> next = i + 1 == stops.size() ? depot : stops[i + 1].location;
+        return costModel.cost(previous, address) + costModel.cost(address, next) - costModel.cost(previous, next);
+    }
+
+    /**
+     * @brief Reorder the stops into a shorter tour.
+     * 
+     * Routes with at most the solver's exact stop limit get an optimal tour from the
+     * Held–Karp solver (cached by stop set); longer routes are improved by 2-opt. The
+     * route never gets longer.
+     * 
+     * @param depot The starting and ending location of the route.
+     * @param costModel The travel cost model used for every leg (Euclidean by default).
+     * @param solver The tour solver holding the exact stop limit and the cache.
+     * @return The total distance of the reordered route.
+     */
+    double optimizeStopOrder(const Address<T>& depot,
+                             const TravelCostModel<T>& costModel = defaultTravelCost<T>(),
+                             TourSolver<T>& solver = defaultTourSolver<T>()) {
+        if (stops.size() < 3) return totalDistance(depot, costModel);
+
+        std::vector<Address<T>> locations;
+        locations.reserve(stops.size());
+        for (const auto& stop : stops) locations.push_back(stop.location);
+
+        typename TourSolver<T>::Tour tour = stops.size() <= solver.getExactStopLimit()
+                                                ? solver.solveExact(depot, locations, costModel)
+                                                : solver.improveTour(depot, locations, costModel);
+
+        // Measure the new order directly rather than trusting the solver's (possibly cached) cost
+        double current = totalDistance(depot, costModel);
+        double reorderedDistance = 0.0;
+        Address<T> previous = depot;
+        for (size_t i : tour.order) {
+            reorderedDistance += costModel.cost(previous, stops[i].location);
+            previous = stops[i].location;
+        }
+        reorderedDistance += costModel.cost(previous, depot);
+        if (reorderedDistance >= current) return current;
+
+        std::vector<Stop> reordered;
+        reordered.reserve(stops.size());
+        for (size_t i : tour.order) reordered.push_back(std::move(stops[i]));
+        stops = std::move(reordered);
+        revision = nextRevision();
+        return reorderedDistance;
+    }
+
+    /**
+     * @brief Get the list of deliveries in the route, expanded from the stops in visiting order.
      * 
      * @return A vector of delivery requests.
      */
     std::vector<DeliveryRequest<T>> getDeliveries() const {
+        std::vector<DeliveryRequest<T>> deliveries;
+        deliveries.reserve(numOrders);
+        for (const auto& stop : stops) {
+            deliveries.insert(deliveries.end(), stop.orders.begin(), stop.orders.end());
+        }
         return deliveries;
     }
 
+    /**
+     * @brief Get the number of deliveries in the route.
+     * 
+     * @return The number of deliveries.
+     */
+    size_t size() const {
+        return numOrders;
+    }
+
+    /**
+     * @brief Get the revision of the route, renewed by every change to its orders or their order.
+     * 
+     * @return The revision, unique across all routes in the process.
+     */
+    uint64_t getRevision() const {
+        return revision;
+    }
+
+    /**
+     * @brief Get the number of stops in the route.
+     * 
+     * @return The number of distinct locations visited.
+     */
+    size_t numStops() const {
+        return stops.size();
+    }
+
+    /**
+     * @brief Visit every delivery in route order without copying the route.
+     * 
+     * @param visit A callable invoked with each delivery request.
+     */
+    template <typename Visitor>
+    void forEachDelivery(Visitor&& visit) const {
+        for (const auto& stop : stops) {
+            for (const auto& delivery : stop.orders) {
+                visit(delivery);
+            }
+        }
+    }
+
+    /**
+     * @brief Visit every stop in route order.
+     * 
+     * @param visit A callable invoked with each stop.
+     */
+    template <typename Visitor>
+    void forEachStop(Visitor&& visit) const {
+        for (const auto& stop : stops) {
+            visit(stop);
+        }
+    }
+
     /**
      * @brief Print the details of the route for a given day.
      * 
      * @param day The day number associated with the route.
      */
     void printRoute(int day) const {
-        std::cout << "Day " << day << ": " << deliveries.size() << " deliveries\n";
-        for (const auto& delivery : deliveries) {
+        std::cout << "Day " << day << ": " << numOrders << " deliveries\n";
+        forEachDelivery([](const DeliveryRequest<T>& delivery) {
             std::cout << " - Address(" << delivery.getAddress().getX()
                       << ", " << delivery.getAddress().getY() << ")";
-        }
-        std::cout << std::endl;
+        });
+        std::cout << '\n';
     }
 };
 
@@ -0,0 +1,292 @@
+#ifndef ROUTEEXPORTER_HPP
+#define ROUTEEXPORTER_HPP
+
+#include "Route.hpp"
+#include "TravelCost.hpp"
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class AsyncFileWriter
+ * @brief Writes filled buffers to a file on a background thread.
+ *
+ * Buffers are handed over by move and recycled once written, so steady-state exports
+ * allocate nothing. At most maxPending buffers wait for the disk; producers block beyond
+ * that to bound memory.
+ */
+class AsyncFileWriter {
+private:
+    std::FILE* file = nullptr; ///< Output file
+    size_t maxPending; ///< Maximum number of buffers waiting to be written
+    std::deque<std::vector<char>> pending; ///< Buffers waiting to be written
+    std::vector<std::vector<char>> recycled; ///< Written buffers available for reuse
+    std::mutex mutex; ///< Guards the queues and the done flag
+    std::condition_variable wakeWriter; ///< Signals new buffers or shutdown
+    std::condition_variable wakeProducer; ///< Signals free space in the queue
+    bool done = false; ///< Set when no more buffers will arrive
+    bool failed = false; ///< Set if a write failed
+    std::thread writer; ///< Background writer thread
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wakeWriter.wait(lock, [this] { return done || !pending.empty(); });
+            if (pending.empty()) break;
+
+            std::vector<char> buffer = std::move(pending.front());
+            pending.pop_front();
+            lock.unlock();
+            if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) failed = true;
+            buffer.clear();
+            lock.lock();
+            recycled.push_back(std::move(buffer));
+            wakeProducer.notify_one();
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor to open the output file and start the writer thread.
+     *
+     * @param filename The name of the output file.
+     * @param maxPendingBuffers The maximum number of buffers waiting to be written.
+     */
+    explicit AsyncFileWriter(const std::string& filename, size_t maxPendingBuffers = 4)
+        : maxPending(maxPendingBuffers) {
+        file = std::fopen(filename.c_str(), "wb");
+        if (file) writer = std::thread(&AsyncFileWriter::run, this);
+    }
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    ~AsyncFileWriter() { close(); }
+
+    /**
+     * @brief Check whether the output file was opened.
+     *
+     * @return True if the file is open.
+     */
+    bool isOpen() const { return file != nullptr; }
+
+    /**
+     * @brief Queue a filled buffer for writing and get an empty one back.
+     *
+     * @param buffer The buffer to write; replaced by an empty buffer for reuse.
+     */
+    void submit(std::vector<char>& buffer) {
+        if (!file || buffer.empty()) return;
+        std::unique_lock<std::mutex> lock(mutex);
+        wakeProducer.wait(lock, [this] { return pending.size() < maxPending; });
+        size_t capacity = buffer.capacity();
+        pending.push_back(std::move(buffer));
+        if (!recycled.empty()) {
+            buffer = std::move(recycled.back());
+            recycled.pop_back();
+        } else {
+            buffer = std::vector<char>();
+            buffer.reserve(capacity);
+        }
+        wakeWriter.notify_one();
+    }
+
+    /**
+     * @brief Write all queued buffers, stop the writer thread and close the file.
+     *
+     * @return True if every write succeeded.
+     */
+    bool close() {
+        if (!file) return !failed;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+        }
+        wakeWriter.notify_one();
+        writer.join();
+        if (std::fclose(file) != 0) failed = true;
+        file = nullptr;
+        return !failed;
+    }
+};
+
+/**
+ * @class RouteExporter
+ * @brief Exports the full ordered stop sequence of every day and vehicle to a CSV file.
+ *
+ * Rows are formatted with std::to_chars into large buffers that a background thread
+ * writes to disk. Days can be streamed with writeDay() as soon as they are finalized;
+ * the total row is written by close().
+ *
+ * @tparam T The type of the coordinates in the Address (e.g., int, float, double).
+ */
+template <typename T>
+class RouteExporter {
+private:
+    static constexpr size_t maxRowLength = 256; ///< Upper bound on the length of one formatted row
+
+    AsyncFileWriter writer; ///< Background file writer
+    std::vector<char> buffer; ///< Buffer currently being filled
+    size_t bufferSize; ///< Buffer size handed to the writer
+    size_t totalStops = 0; ///< Number of stops written so far (consolidated orders count once)
+    double totalDistance = 0.0; ///< Distance of all routes written so far
+    bool closed = false; ///< Set once close() has run
+
+    void append(const char* text) {
+        buffer.insert(buffer.end(), text, text + std::strlen(text));
+    }
+
+    template <typename Number>
+    void append(Number value) {
+        char digits[64];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        buffer.insert(buffer.end(), digits, result.ptr);
+    }
+
+    void reserveRow() {
+        if (buffer.size() + maxRowLength > bufferSize) writer.submit(buffer);
+    }
+
+public:
+    /**
+     * @brief Constructor to open the output file and write the header.
+     *
+     * @param filename The name of the output file.
+     * @param bufferBytes The size of every buffer handed to the writer thread.
+     */
+    explicit RouteExporter(const std::string& filename, size_t bufferBytes = 1 << 20)
+        : writer(filename), bufferSize(std::max(bufferBytes, 2 * maxRowLength)) {
+        if (!writer.isOpen()) {
+            std::cerr << "Error opening file for export.\n";
+            return;
+        }
+        buffer.reserve(bufferSize);
+        append("Day,Vehicle,Stop,X,Y,PlacementDate,EarliestDeliveryDate,LatestDeliveryDate,IsPrime,CumulativeDistance\n");
+    }
+
+    RouteExporter(const RouteExporter&) = delete;
+    RouteExporter& operator=(const RouteExporter&) = delete;
+
+    ~RouteExporter() { close(); }
+
+    /**
+     * @brief Check whether the output file was opened.
+     *
+     * @return True if the file is open.
+     */
+    bool isOpen() const { return writer.isOpen(); }
+
+    /**
+     * @brief Write one vehicle's route for a day, ending with the return to the depot.
+     *
+     * Every order gets its own row; orders sharing a stop share its stop number and
+     * cumulative distance.
+     *
+     * @param day The day of the route.
+     * @param vehicle The vehicle (or zone) serving the route.
+     * @param route The route to write.
+     * @param depot The starting and ending location of the route.
+     * @param costModel The travel cost model used for the cumulative distance.
+     */
+    void writeRoute(int day, size_t vehicle, const Route<T>& route, const Address<T>& depot,
+                    const TravelCostModel<T>& costModel = defaultTravelCost<T>()) {
+        if (!isOpen() || closed || route.size() == 0) return;
+
+        double cumulative = 0.0;
+        size_t stop = 0;
+        Address<T> currentLocation = depot;
+        route.forEachStop([&](const typename Route<T>::Stop& routeStop) {
+            cumulative += costModel.cost(currentLocation, routeStop.location);
+            currentLocation = routeStop.location;
+            ++stop;
+
+            // Consolidated stops expand back into one row per order
+            for (const auto& delivery : routeStop.orders) {
+                const Address<T> address = delivery.getAddress();
+                reserveRow();
+                append(day); append(",");
+                append(vehicle); append(",");
+                append(stop); append(",");
+                append(address.getX()); append(",");
+                append(address.getY()); append(",");
+                append(delivery.getPlacementDate()); append(",");
+                append(delivery.getEarliestDeliveryDate()); append(",");
+                append(delivery.getLatestDeliveryDate()); append(",");
+                append(delivery.getIsPrime() ? "1," : "0,");
+                append(cumulative); append("\n");
+            }
+        });
+
+        // Return to depot
+        cumulative += costModel.cost(currentLocation, depot);
+        reserveRow();
+        append(day); append(",");
+        append(vehicle); append(",");
+        append(++stop); append(",");
+        append(depot.getX()); append(",");
+        append(depot.getY()); append(",,,,,");
+        append(cumulative); append("\n");
+
+        totalStops += route.numStops();
+        totalDistance += cumulative;
+    }
+
+    /**
+     * @brief Stream every vehicle's route for a finalized day.
+     *
+     * @param day The day of the routes.
+     * @param vehicleRoutes The route of every vehicle, indexed by vehicle.
+     * @param depot The starting and ending location of the routes.
+     * @param costModel The travel cost model used for the cumulative distance.
+     */
+    void writeDay(int day, const std::vector<const Route<T>*>& vehicleRoutes, const Address<T>& depot,
+                  const TravelCostModel<T>& costModel = defaultTravelCost<T>()) {
+        for (size_t vehicle = 0; vehicle < vehicleRoutes.size(); ++vehicle) {
+            if (vehicleRoutes[vehicle]) writeRoute(day, vehicle, *vehicleRoutes[vehicle], depot, costModel);
+        }
+    }
+
+    /**
+     * @brief Write the total row, flush all buffers and close the file.
+     *
+     * @return True if every write succeeded.
+     */
+    bool close() {
+        if (closed) return true;
+        closed = true;
+        if (!isOpen()) return false;
+
+        reserveRow();
+        append("Total,,");
+        append(totalStops);
+        append(",,,,,,,");
+        append(totalDistance);
+        append("\n");
+        writer.submit(buffer);
+        return writer.close();
+    }
+
+    /**
+     * @brief Get the number of stops written so far.
+     *
+     * @return The number of stops.
+     */
+    size_t getTotalStops() const { return totalStops; }
+
+    /**
+     * @brief Get the distance of all routes written so far.
+     *
+     * @return The total distance.
+     */
+    double getTotalDistance() const { return totalDistance; }
+};
+
+#endif // ROUTEEXPORTER_HPP
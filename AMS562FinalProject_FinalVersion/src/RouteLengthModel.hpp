@@ -0,0 +1,383 @@
+#ifndef ROUTELENGTHMODEL_HPP
+#define ROUTELENGTHMODEL_HPP
+
+#include "Address.hpp"
+#include "Route.hpp"
+#include "TravelCost.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ScreeningStats
+ * @brief Counters collected while optimizing with surrogate screening.
+ *
+ * Hits and regret are only measured in audit mode, where the unscreened candidates are
+ * evaluated exactly as well (without changing the moves that are made).
+ */
+struct ScreeningStats {
+    bool audit = false; ///< Also evaluate the screened-out candidates to measure hits and regret
+    size_t decisions = 0; ///< Deliveries with more candidate days than were evaluated exactly
+    size_t candidates = 0; ///< Candidate days ranked by the surrogate
+    size_t exactEvaluations = 0; ///< Candidate days evaluated exactly
+    size_t fallbackEvaluations = 0; ///< Exact evaluations beyond the top-k, of days ranked too close to tell apart
+    size_t auditedDecisions = 0; ///< Decisions checked against the full search (audit mode only)
+    size_t hits = 0; ///< Audited decisions whose exact best candidate was kept by the screen
+    double totalRegret = 0.0; ///< Summed distance lost by audited decisions against the full search
+    double maxRegret = 0.0; ///< Largest distance lost by a single audited decision
+
+    /**
+     * @brief Fraction of audited decisions whose exact best candidate survived the screen.
+     *
+     * @return The hit rate (1 if no candidate was screened out), or NaN if not measured (audit off).
+     */
+    double hitRate() const {
+        if (!audit) return std::numeric_limits<double>::quiet_NaN();
+        return auditedDecisions == 0 ? 1.0 : static_cast<double>(hits) / auditedDecisions;
+    }
+
+    /**
+     * @brief Mean distance lost per audited decision.
+     *
+     * @return The mean regret, or NaN if not measured (audit off).
+     */
+    double meanRegret() const {
+        if (!audit) return std::numeric_limits<double>::quiet_NaN();
+        return auditedDecisions == 0 ? 0.0 : totalRegret / auditedDecisions;
+    }
+};
+
+/**
+ * @class StopGrid
+ * @brief The stops of a route bucketed on a uniform grid, for nearest-stop queries.
+ *
+ * A query searches the cells in rings around the location's cell and stops once no
+ * further ring can hold a nearer stop, so it touches only the stops close to the location.
+ * Stops and locations outside the grid are clamped to its border cells.
+ *
+ * @tparam T The type of the coordinates in the Address (e.g., int, float, double).
+ */
+template <typename T>
+class StopGrid {
+private:
+    double left; ///< Left edge of the grid
+    double bottom; ///< Bottom edge of the grid
+    double cellSize; ///< Side length of a cell
+    int cellsPerSide; ///< Number of cells along each side
+    std::vector<size_t> cellStart; ///< Offset of each cell's first stop in points, row by row, plus the end
+    std::vector<std::pair<double, double>> points; ///< Stop coordinates sorted by cell
+
+    int cellIndex(double coordinate, double origin) const {
+        double index = std::floor((coordinate - origin) / cellSize);
+        return static_cast<int>(std::clamp(index, 0.0, cellsPerSide - 1.0));
+    }
+
+public:
+    /**
+     * @brief Construct an empty grid.
+     *
+     * @param left Left edge of the grid.
+     * @param bottom Bottom edge of the grid.
+     * @param size Side length of a cell (positive).
+     * @param count Number of cells along each side (at least 1).
+     */
+    StopGrid(double left, double bottom, double size, int count)
+        : left(left), bottom(bottom), cellSize(size), cellsPerSide(count), cellStart(static_cast<size_t>(count) * count + 1, 0) {}
+
+    /**
+     * @brief Replace the contents of the grid with the stops of a route.
+     *
+     * @param route The route.
+     */
+    void assign(const Route<T>& route) {
+        // Counting sort of the stops by cell
+        std::vector<size_t> stopCells;
+        stopCells.reserve(route.numStops());
+        std::fill(cellStart.begin(), cellStart.end(), 0);
+        route.forEachStop([&](const typename Route<T>::Stop& stop) {
+            int column = cellIndex(static_cast<double>(stop.location.getX()), left);
+            int row = cellIndex(static_cast<double>(stop.location.getY()), bottom);
+            stopCells.push_back(static_cast<size_t>(row) * cellsPerSide + column);
+            ++cellStart[stopCells.back() + 1];
+        });
+        for (size_t cell = 1; cell < cellStart.size(); ++cell) cellStart[cell] += cellStart[cell - 1];
+
+        points.resize(stopCells.size());
+        std::vector<size_t> next(cellStart.begin(), cellStart.end() - 1);
+        size_t i = 0;
+        route.forEachStop([&](const typename Route<T>::Stop& stop) {
+            points[next[stopCells[i++]]++] = {static_cast<double>(stop.location.getX()),
+                                              static_cast<double>(stop.location.getY())};
+        });
+    }
+
+    /**
+     * @brief Get the number of stops in the grid.
+     */
+    size_t size() const {
+        return points.size();
+    }
+
+    /**
+     * @brief Straight-line distance from a location to the nearest stop.
+     *
+     * @param location The location.
+     * @return The distance (0 at a stop's address), or infinity if the grid is empty.
+     */
+    double nearestDistance(const Address<T>& location) const {
+        double best = std::numeric_limits<double>::infinity();
+        if (points.empty()) return best;
+
+        double x = static_cast<double>(location.getX()), y = static_cast<double>(location.getY());
+        int column = cellIndex(x, left), row = cellIndex(y, bottom);
+        for (int ring = 0; ring < cellsPerSide; ++ring) {
+            for (int r = std::max(row - ring, 0); r <= std::min(row + ring, cellsPerSide - 1); ++r) {
+                // Inner rows of a ring only contribute their two outermost cells
+                int step = (r == row - ring || r == row + ring) ? 1 : 2 * ring;
+                for (int c = column - ring; c <= column + ring; c += step) {
+                    if (c < 0 || c >= cellsPerSide) continue;
+                    size_t cell = static_cast<size_t>(r) * cellsPerSide + c;
+                    for (size_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+                        double dx = points[i].first - x, dy = points[i].second - y;
+                        best = std::min(best, dx * dx + dy * dy);
+                    }
+                }
+            }
+            // Every cell outside this ring is at least ring * cellSize away
+            double reach = ring * cellSize;
+            if (best <= reach * reach) break;
+        }
+        return std::sqrt(best);
+    }
+};
+
+/**
+ * @class RouteLengthModel
+ * @brief Cheap estimate of a route's length from its stop count and the area it covers.
+ *
+ * Follows the Beardwood-Halton-Hammersley law for the optimal tour through n random
+ * points in an area A, extended by a per-stop term and a constant for the depot legs:
+ *
+ *     length ~ areaCoefficient * sqrt(n * A) + stopCoefficient * n + intercept
+ *
+ * The defaults are the asymptotic constant for the plane (0.7124) and no other terms;
+ * calibrate fits all three coefficients to the days of a schedule, and save/load keep a
+ * fitted model for later runs on the same dataset.
+ *
+ * @tparam T The type of the coordinates in the Address (e.g., int, float, double).
+ */
+template <typename T>
+class RouteLengthModel {
+private:
+    static constexpr double planeConstant = 0.7124; ///< Asymptotic BHH constant for the Euclidean plane
+    double areaCoefficient = planeConstant; ///< Weight of sqrt(n * A)
+    double stopCoefficient = 0.0; ///< Length added per stop
+    double intercept = 0.0; ///< Constant length of a non-empty route
+
+    /**
+     * @brief Solve a linear system in place by Gauss-Jordan elimination with partial pivoting.
+     *
+     * @param system The augmented matrix, right-hand side in the last column, which holds the solution on success.
+     * @param size The number of unknowns.
+     * @return False if the system is singular.
+     */
+    static bool solveLinearSystem(double (&system)[3][4], int size) {
+        for (int column = 0; column < size; ++column) {
+            int pivot = column;
+            for (int row = column + 1; row < size; ++row) {
+                if (std::abs(system[row][column]) > std::abs(system[pivot][column])) pivot = row;
+            }
+            if (std::abs(system[pivot][column]) < 1e-9 * (1.0 + std::abs(system[0][0]))) return false;
+            std::swap(system[column], system[pivot]);
+            for (int row = 0; row < size; ++row) {
+                if (row == column) continue;
+                double factor = system[row][column] / system[column][column];
+                for (int k = column; k < 4; ++k) system[row][k] -= factor * system[column][k];
+            }
+        }
+        for (int row = 0; row < size; ++row) system[row][3] /= system[row][row];
+        return true;
+    }
+
+    /**
+     * @brief Least-squares fit of the intercept and a chosen subset of the other coefficients.
+     *
+     * Coefficients left out keep their fallback: the plane constant for the area term and
+     * zero for the per-stop term.
+     *
+     * @param normal Normal equations for the features sqrt(n * A), n and 1.
+     * @param fitArea Whether to fit the area coefficient.
+     * @param fitStops Whether to fit the per-stop coefficient.
+     * @return False if the fit is singular or the area coefficient is not positive.
+     */
+    bool fitCoefficients(const double (&normal)[3][4], bool fitArea, bool fitStops) {
+        const double fixed[3] = {fitArea ? 0.0 : planeConstant, 0.0, 0.0};
+        int features[3], size = 0;
+        if (fitArea) features[size++] = 0;
+        if (fitStops) features[size++] = 1;
+        features[size++] = 2;
+
+        // Move the fixed terms to the right-hand side
+        double system[3][4] = {};
+        for (int i = 0; i < size; ++i) {
+            for (int j = 0; j < size; ++j) system[i][j] = normal[features[i]][features[j]];
+            system[i][3] = normal[features[i]][3] - fixed[0] * normal[features[i]][0];
+        }
+        if (!solveLinearSystem(system, size)) return false;
+
+        double solution[3] = {fixed[0], fixed[1], fixed[2]};
+        for (int i = 0; i < size; ++i) solution[features[i]] = system[i][3];
+        if (solution[0] <= 0.0) return false;
+
+        areaCoefficient = solution[0];
+        stopCoefficient = solution[1];
+        intercept = solution[2];
+        return true;
+    }
+
+public:
+    RouteLengthModel() = default;
+
+    /**
+     * @brief Construct a model with given coefficients.
+     */
+    RouteLengthModel(double area, double stop, double constant)
+        : areaCoefficient(area), stopCoefficient(stop), intercept(constant) {}
+
+    double getAreaCoefficient() const { return areaCoefficient; }
+    double getStopCoefficient() const { return stopCoefficient; }
+    double getIntercept() const { return intercept; }
+
+    /**
+     * @brief Area of the bounding box of a route's stops and the depot.
+     *
+     * @param route The route.
+     * @param depot The location of the depot.
+     * @return The bounding-box area.
+     */
+    static double coveredArea(const Route<T>& route, const Address<T>& depot) {
+        double minX = depot.getX(), maxX = depot.getX(), minY = depot.getY(), maxY = depot.getY();
+        route.forEachStop([&](const typename Route<T>::Stop& stop) {
+            minX = std::min(minX, static_cast<double>(stop.location.getX()));
+            maxX = std::max(maxX, static_cast<double>(stop.location.getX()));
+            minY = std::min(minY, static_cast<double>(stop.location.getY()));
+            maxY = std::max(maxY, static_cast<double>(stop.location.getY()));
+        });
+        return (maxX - minX) * (maxY - minY);
+    }
+
+    /**
+     * @brief Estimated length of a route.
+     *
+     * @param stops The number of stops.
+     * @param area The area the stops cover.
+     * @return The estimated length (0 for an empty route).
+     */
+    double estimate(size_t stops, double area) const {
+        if (stops == 0) return 0.0;
+        return areaCoefficient * std::sqrt(stops * area) + stopCoefficient * stops + intercept;
+    }
+
+    /**
+     * @brief Estimated length added to a route by a stop at a given distance from its nearest stop.
+     *
+     * For n stops spread over an area A, a stop's nearest neighbour is about sqrt(A / n) / 2
+     * away, and one more stop inside the area lengthens the tour by about
+     * areaCoefficient * sqrt(A / n) / 2, the growth of the BHH term. So the added length is
+     * estimated as the area coefficient times the distance to the nearest stop; an order at
+     * an existing stop's address adds nothing. The per-stop term is left out: it is the same
+     * for every route, so it would not change how candidate routes rank.
+     *
+     * @param nearestStop Distance from the new location to the route's nearest stop or the depot.
+     * @return The estimated added length.
+     */
+    double insertionLength(double nearestStop) const {
+        return areaCoefficient * nearestStop;
+    }
+
+    /**
+     * @brief Fit the coefficients to the non-empty days of a schedule by least squares.
+     *
+     * @param routes The daily routes to fit.
+     * @param depot The location of the depot.
+     * @param costModel The travel cost model used for the true route lengths.
+     * @return False (keeping the current coefficients) if the days do not determine a fit.
+     */
+    bool calibrate(const std::map<int, Route<T>>& routes, const Address<T>& depot,
+                   const TravelCostModel<T>& costModel = defaultTravelCost<T>()) {
+        // Normal equations for the features sqrt(n * A), n and 1
+        double normal[3][4] = {};
+        size_t samples = 0;
+        for (const auto& [day, route] : routes) {
+            if (route.numStops() == 0) continue;
+            double features[3] = {std::sqrt(route.numStops() * coveredArea(route, depot)),
+                                  static_cast<double>(route.numStops()), 1.0};
+            double length = route.totalDistance(depot, costModel);
+            for (int i = 0; i < 3; ++i) {
+                for (int j = 0; j < 3; ++j) normal[i][j] += features[i] * features[j];
+                normal[i][3] += features[i] * length;
+            }
+            ++samples;
+        }
+        if (samples < 3) {
+            std::cerr << "Too few routes to calibrate the route length model: " << samples << std::endl;
+            return false;
+        }
+
+        // Days that all span the whole service area leave sqrt(n * A) nearly collinear with n,
+        // and days of equal size leave n collinear with the intercept: drop terms until the fit is determined
+        if (fitCoefficients(normal, true, true) || fitCoefficients(normal, true, false) ||
+            fitCoefficients(normal, false, true) || fitCoefficients(normal, false, false)) {
+            return true;
+        }
+        std::cerr << "Route lengths do not determine the route length model" << std::endl;
+        return false;
+    }
+
+    /**
+     * @brief Read the coefficients from a file written by save.
+     *
+     * @param filename The name of the model file.
+     * @return False (keeping the current coefficients) if the file cannot be read.
+     */
+    bool load(const std::string& filename) {
+        std::ifstream inFile(filename);
+        if (!inFile.is_open()) {
+            std::cerr << "Error opening route length model: " << filename << std::endl;
+            return false;
+        }
+        double area, stop, constant;
+        if (!(inFile >> area >> stop >> constant)) {
+            std::cerr << "Malformed route length model: " << filename << std::endl;
+            return false;
+        }
+        areaCoefficient = area;
+        stopCoefficient = stop;
+        intercept = constant;
+        return true;
+    }
+
+    /**
+     * @brief Write the coefficients as one line: area, per-stop and constant term.
+     *
+     * @param filename The name of the model file.
+     * @return False if the file cannot be written.
+     */
+    bool save(const std::string& filename) const {
+        std::ofstream outFile(filename);
+        if (!outFile.is_open()) {
+            std::cerr << "Error opening route length model for writing: " << filename << std::endl;
+            return false;
+        }
+        outFile.precision(17);
+        outFile << areaCoefficient << " " << stopCoefficient << " " << intercept << "\n";
+        return static_cast<bool>(outFile);
+    }
+};
+
+#endif // ROUTELENGTHMODEL_HPP
@@ -2,11 +2,29 @@
 #define SCHEDULEBALANCED_HPP
 
 #include "Route.hpp"
+#include "TravelCost.hpp"
+#include "RouteExporter.hpp"
+#include "RouteLengthModel.hpp"
 #include <map>
+#include <algorithm>
+#include <queue>
+#include <cmath>
+#include <limits>
+#include <memory>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 
+/**
+ * @enum SeedingStrategy
+ * @brief How planRoutes assigns new deliveries to days.
+ */
+enum class SeedingStrategy {
+    EarliestDay, ///< Every delivery on its earliest delivery date
+    LocationClusters, ///< Nearby deliveries with overlapping windows share a day
+    RegretInsertion ///< Cheapest day first for deliveries with the most to lose
+};
+
 /**
  * @class ScheduleBalanced
  * @brief Manages scheduling with templated routes and addresses.
@@ -20,8 +38,266 @@ private:
     int startDay = 8; ///< Start of the middle-section days
     int endDay = 53; ///< End of the middle-section days
     double redistributionThreshold = 1; ///< Threshold for triggering workload redistribution
+    std::shared_ptr<const TravelCostModel<T>> travelCost; ///< Travel cost model (Euclidean if null)
+    int lastStreamedDay = std::numeric_limits<int>::min(); ///< Last day written by streamFinalizedDays
+    double clusterCellSize = 0.5; ///< Grid cell size used to group nearby deliveries when seeding
+    double overloadPenalty = 1.0; ///< Seeding cost per delivery above a day's load target
+    double stopMergeTolerance = 0.0; ///< Grid size within which orders share a stop (0: identical only)
+
+    /**
+     * @brief First and last day any scheduled delivery may be delivered on.
+     */
+    std::pair<int, int> planningHorizon() const {
+        int firstDay = std::numeric_limits<int>::max(), lastDay = std::numeric_limits<int>::min();
+        for (const auto& [day, route] : dailyRoutes) {
+            route.forEachDelivery([&](const DeliveryRequest<T>& delivery) {
+                firstDay = std::min(firstDay, delivery.getEarliestDeliveryDate());
+                lastDay = std::max(lastDay, delivery.getLatestDeliveryDate());
+            });
+        }
+        return {firstDay, lastDay};
+    }
+
+    /**
+     * @brief Number of deliveries per day that spreads existing and new deliveries evenly.
+     */
+    double loadTarget(const std::vector<DeliveryRequest<T>>& deliveryRequests) const {
+        auto [firstDay, lastDay] = planningHorizon();
+        size_t count = deliveryRequests.size();
+        for (const auto& [day, route] : dailyRoutes) count += route.size();
+        for (const auto& delivery : deliveryRequests) {
+            firstDay = std::min(firstDay, delivery.getEarliestDeliveryDate());
+            lastDay = std::max(lastDay, delivery.getLatestDeliveryDate());
+        }
+        if (firstDay > lastDay) return 1.0;
+        return std::ceil(count / (lastDay - firstDay + 1.0));
+    }
+
+    /**
+     * @brief Seed by grouping nearby deliveries whose windows overlap and giving each group one day.
+     * 
+     * Deliveries in the same grid cell are taken in deadline order; a group keeps the
+     * intersection of its members' windows and closes when the next window no longer
+     * overlaps it or the group reaches the load target. Groups with the tightest windows
+     * pick first, each taking the least loaded day of its window.
+     */
+    void seedLocationClusters(const std::vector<DeliveryRequest<T>>& deliveryRequests, const Address<T>& depot) {
+        const TravelCostModel<T>& costModel = getTravelCostModel();
+        const size_t maxClusterSize = static_cast<size_t>(loadTarget(deliveryRequests));
+
+        std::map<std::pair<long, long>, std::vector<size_t>> cells;
+        for (size_t i = 0; i < deliveryRequests.size(); ++i) {
+            const Address<T> address = deliveryRequests[i].getAddress();
+            cells[{static_cast<long>(std::floor(address.getX() / clusterCellSize)),
+                   static_cast<long>(std::floor(address.getY() / clusterCellSize))}].push_back(i);
+        }
+
+        struct Cluster {
+            int firstDay; ///< Earliest day every member can be delivered on
+            int lastDay; ///< Latest day every member can be delivered on
+            std::vector<size_t> members; ///< Indices into deliveryRequests
+        };
+        std::vector<Cluster> clusters;
+        for (auto& [cell, members] : cells) {
+            std::sort(members.begin(), members.end(), [&](size_t a, size_t b) {
+                const auto& da = deliveryRequests[a];
+                const auto& db = deliveryRequests[b];
+                if (da.getLatestDeliveryDate() != db.getLatestDeliveryDate()) {
+                    return da.getLatestDeliveryDate() < db.getLatestDeliveryDate();
+                }
+                return da.getEarliestDeliveryDate() < db.getEarliestDeliveryDate();
+            });
+
+            size_t open = clusters.size(); // index of the group still accepting members
+            for (size_t index : members) {
+                const auto& delivery = deliveryRequests[index];
+                int first = delivery.getEarliestDeliveryDate(), last = delivery.getLatestDeliveryDate();
+                if (open < clusters.size() && clusters[open].members.size() < maxClusterSize &&
+                    std::max(clusters[open].firstDay, first) <= std::min(clusters[open].lastDay, last)) {
+                    clusters[open].firstDay = std::max(clusters[open].firstDay, first);
+                    clusters[open].lastDay = std::min(clusters[open].lastDay, last);
+                    clusters[open].members.push_back(index);
+                } else {
+                    open = clusters.size();
+                    clusters.push_back({first, last, {index}});
+                }
+            }
+        }
+
+        std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) {
+            if (a.lastDay - a.firstDay != b.lastDay - b.firstDay) return a.lastDay - a.firstDay < b.lastDay - b.firstDay;
+            return a.lastDay < b.lastDay;
+        });
+
+        for (const auto& cluster : clusters) {
+            int bestDay = cluster.firstDay;
+            size_t bestLoad = std::numeric_limits<size_t>::max();
+            for (int day = cluster.firstDay; day <= cluster.lastDay; ++day) {
+                auto route = dailyRoutes.find(day);
+                size_t load = route == dailyRoutes.end() ? 0 : route->second.size();
+                if (load < bestLoad) {
+                    bestLoad = load;
+                    bestDay = day;
+                }
+            }
+
+            Route<T>& route = getRoute(bestDay);
+            for (size_t index : cluster.members) {
+                size_t position = 0;
+                route.insertionCost(deliveryRequests[index], depot, costModel, &position);
+                route.insertDelivery(deliveryRequests[index], position);
+            }
+        }
+    }
+
+    /**
+     * @brief Seed by regret insertion across each delivery's feasible days.
+     * 
+     * A day's cost is the cheapest insertion into its route plus overloadPenalty for every
+     * delivery beyond the load target. The delivery with the largest gap between its best and
+     * second-best day is placed next; deliveries with a single feasible day go first. Regrets
+     * are recomputed lazily: an entry is only trusted if none of its days changed since.
+     */
+    void seedRegretInsertion(const std::vector<DeliveryRequest<T>>& deliveryRequests, const Address<T>& depot) {
+        const TravelCostModel<T>& costModel = getTravelCostModel();
+        const double target = loadTarget(deliveryRequests);
+        std::map<int, long> dayVersion; // incremented whenever a day's route changes
+
+        struct Choice {
+            double regret; ///< Second-best minus best day cost
+            int day; ///< Best day
+            size_t position; ///< Cheapest insertion position on the best day
+            long stamp; ///< Sum of the versions of the feasible days when evaluated
+        };
+        auto evaluate = [&](const DeliveryRequest<T>& delivery) {
+            double best = std::numeric_limits<double>::infinity(), secondBest = best;
+            Choice choice{0.0, delivery.getEarliestDeliveryDate(), 0, 0};
+            for (int day = delivery.getEarliestDeliveryDate(); day <= delivery.getLatestDeliveryDate(); ++day) {
+                choice.stamp += dayVersion[day];
+                auto route = dailyRoutes.find(day);
+                size_t position = 0;
+                double cost = route == dailyRoutes.end()
+                                  ? costModel.cost(depot, delivery.getAddress()) + costModel.cost(delivery.getAddress(), depot)
+                                  : route->second.insertionCost(delivery, depot, costModel, &position);
+                size_t load = route == dailyRoutes.end() ? 0 : route->second.size();
+                cost += overloadPenalty * std::max(0.0, load + 1.0 - target);
+                if (cost < best) {
+                    secondBest = best;
+                    best = cost;
+                    choice.day = day;
+                    choice.position = position;
+                } else if (cost < secondBest) {
+                    secondBest = cost;
+                }
+            }
+            choice.regret = std::isinf(secondBest) ? std::numeric_limits<double>::max() : secondBest - best;
+            return choice;
+        };
+        auto currentStamp = [&](const DeliveryRequest<T>& delivery) {
+            long stamp = 0;
+            for (int day = delivery.getEarliestDeliveryDate(); day <= delivery.getLatestDeliveryDate(); ++day) {
+                stamp += dayVersion[day];
+            }
+            return stamp;
+        };
+
+        using Entry = std::pair<double, size_t>; // (regret, index into deliveryRequests)
+        std::priority_queue<Entry> queue;
+        std::vector<Choice> choices(deliveryRequests.size());
+        for (size_t i = 0; i < deliveryRequests.size(); ++i) {
+            choices[i] = evaluate(deliveryRequests[i]);
+            queue.push({choices[i].regret, i});
+        }
+
+        while (!queue.empty()) {
+            size_t index = queue.top().second;
+            queue.pop();
+            const auto& delivery = deliveryRequests[index];
+            if (choices[index].stamp != currentStamp(delivery)) {
+                choices[index] = evaluate(delivery);
+                queue.push({choices[index].regret, index});
+                continue;
+            }
+
+            getRoute(choices[index].day).insertDelivery(delivery, choices[index].position);
+            ++dayVersion[choices[index].day];
+        }
+    }
+
+    /**
+     * @brief Exact total distance after inserting a delivery into another day at its cheapest position.
+     * 
+     * Evaluated on the unchanged routes, so trial moves neither touch a route's revision nor
+     * create routes for empty days.
+     * 
+     * @param delivery The delivery to move.
+     * @param day The day to move it to.
+     * @param baseDistance The total distance with the delivery already removed from its day.
+     * @param depot The location of the depot.
+     * @param position If not null, receives the insertion position in the day's route.
+     * @return The total distance with the delivery on the given day.
+     */
+    double totalAfterMove(const DeliveryRequest<T>& delivery, int day, double baseDistance, const Address<T>& depot,
+                          size_t* position = nullptr) const {
+        auto target = dailyRoutes.find(day);
+        if (target == dailyRoutes.end()) {
+            if (position) *position = 0;
+            const Address<T>& address = delivery.getAddress();
+            return baseDistance + getTravelCostModel().cost(depot, address) + getTravelCostModel().cost(address, depot);
+        }
+        return baseDistance + target->second.insertionCost(delivery, depot, getTravelCostModel(), position);
+    }
 
 public:
+    /**
+     * @brief Set the travel cost model used for all route distances.
+     * 
+     * @param model The travel cost model, or nullptr to use straight-line distances.
+     */
+    void setTravelCostModel(std::shared_ptr<const TravelCostModel<T>> model) {
+        travelCost = std::move(model);
+    }
+
+    /**
+     * @brief Get the travel cost model used for all route distances.
+     * 
+     * @return The active travel cost model.
+     */
+    const TravelCostModel<T>& getTravelCostModel() const {
+        return travelCost ? *travelCost : defaultTravelCost<T>();
+    }
+
+    /**
+     * @brief Get the routes of all scheduled days.
+     * 
+     * @return A map of days to their corresponding routes.
+     */
+    const std::map<int, Route<T>>& getDailyRoutes() const {
+        return dailyRoutes;
+    }
+
+    /**
+     * @brief Get the route of a day, creating an empty route if none exists.
+     * 
+     * @param day The day of the route.
+     * @return The route of the day.
+     */
+    Route<T>& getRoute(int day) {
+        return dailyRoutes.try_emplace(day, stopMergeTolerance).first->second;
+    }
+
+    /**
+     * @brief Set the distance within which orders on the same day are consolidated into one stop.
+     * 
+     * Applies to routes created afterwards; call before planning.
+     * 
+     * @param tolerance Grid size for merging addresses (0 merges identical addresses only, a negative
+     *                  value disables merging).
+     */
+    void setStopMergeTolerance(double tolerance) {
+        stopMergeTolerance = tolerance;
+    }
+
     /**
      * @brief Plan routes by assigning deliveries to their best days.
      * 
@@ -30,10 +306,66 @@ public:
     void planRoutes(const std::vector<DeliveryRequest<T>>& deliveryRequests) {
         for (const auto& delivery : deliveryRequests) {
             int bestDay = delivery.getEarliestDeliveryDate();
-            dailyRoutes[bestDay].addDelivery(delivery);
+            getRoute(bestDay).addDelivery(delivery);
+        }
+    }
+
+    /**
+     * @brief Plan routes with a constructive seeding strategy.
+     * 
+     * Deliveries already scheduled stay where they are; the new deliveries are added around them.
+     * 
+     * @param deliveryRequests A list of delivery requests to schedule.
+     * @param depot The location of the depot.
+     * @param strategy How deliveries are assigned to days.
+     */
+    void planRoutes(const std::vector<DeliveryRequest<T>>& deliveryRequests, const Address<T>& depot,
+                    SeedingStrategy strategy) {
+        switch (strategy) {
+            case SeedingStrategy::EarliestDay:
+                planRoutes(deliveryRequests);
+                break;
+            case SeedingStrategy::LocationClusters:
+                seedLocationClusters(deliveryRequests, depot);
+                break;
+            case SeedingStrategy::RegretInsertion:
+                seedRegretInsertion(deliveryRequests, depot);
+                break;
         }
     }
 
+    /**
+     * @brief Remove a scheduled delivery from whichever day in its window holds it.
+     * 
+     * @param delivery The delivery request to remove (one occurrence if identical orders exist).
+     * @return True if the delivery was found and removed.
+     */
+    bool cancelDelivery(const DeliveryRequest<T>& delivery) {
+        for (int day = delivery.getEarliestDeliveryDate(); day <= delivery.getLatestDeliveryDate(); ++day) {
+            auto route = dailyRoutes.find(day);
+            if (route == dailyRoutes.end()) continue;
+
+            size_t before = route->second.size();
+            route->second.removeDelivery(delivery);
+            if (route->second.size() < before) {
+                if (route->second.size() == 0) dailyRoutes.erase(route);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Set the parameters of the constructive seeding strategies.
+     * 
+     * @param cellSize Grid cell size used to group nearby deliveries.
+     * @param penalty Seeding cost per delivery above a day's load target.
+     */
+    void setSeedingParameters(double cellSize, double penalty) {
+        clusterCellSize = cellSize;
+        overloadPenalty = penalty;
+    }
+
     /**
      * @brief Balance the workload by redistributing deliveries across days.
      * 
@@ -48,9 +380,10 @@ public:
             int overloadedDay = -1, underloadedDay = -1;
             double maxDistance = -1.0, minDistance = 1e9;
 
-            // Identify overloaded and underloaded days
+            // Identify overloaded and underloaded days (days without a route count as empty)
             for (int day = startDay; day <= endDay; ++day) {
-                double dailyDistance = dailyRoutes[day].totalDistance(depot);
+                auto it = dailyRoutes.find(day);
+                double dailyDistance = it == dailyRoutes.end() ? 0.0 : it->second.totalDistance(depot, getTravelCostModel());
                 if (dailyDistance > maxDistance) {
                     maxDistance = dailyDistance;
                     overloadedDay = day;
@@ -67,14 +400,16 @@ public:
 
             // Redistribute deliveries if conditions are met
             if (overloadedDay != -1 && underloadedDay != -1 && maxDistance - minDistance > dynamicThreshold) {
-                auto& overloadedRoute = dailyRoutes[overloadedDay];
-                auto& underloadedRoute = dailyRoutes[underloadedDay];
+                auto& overloadedRoute = getRoute(overloadedDay);
                 auto deliveries = overloadedRoute.getDeliveries();
 
                 for (const auto& delivery : deliveries) {
                     if (delivery.isWithinDeliveryWindow(underloadedDay)) {
+                        // Skip moves that would overload the target day, which could oscillate forever
+                        size_t position = 0;
+                        if (totalAfterMove(delivery, underloadedDay, minDistance, depot, &position) >= maxDistance) continue;
+                        getRoute(underloadedDay).insertDelivery(delivery, position);
                         overloadedRoute.removeDelivery(delivery);
-                        underloadedRoute.addDelivery(delivery);
                         changesMade = true;
                         break; // Adjust one delivery at a time
                     }
@@ -86,6 +421,9 @@ public:
     /**
      * @brief Optimize all routes to minimize total distance after balancing.
      * 
+     * Every delivery moves to the day in its window, and the position in that day's route,
+     * with the cheapest insertion, as long as that shortens the total.
+     * 
      * @param depot The location of the depot.
      */
     void optimizeAllRoutes(const Address<T>& depot) {
@@ -100,38 +438,291 @@ public:
 
                 for (const auto& delivery : deliveries) {
                     int bestDay = currentDay;
+                    size_t bestPosition = 0;
                     double bestDistance = currentTotalDistance;
+                    double removedDistance = route.removalGain(delivery, depot, getTravelCostModel());
 
                     for (int day = delivery.getEarliestDeliveryDate(); day <= delivery.getLatestDeliveryDate(); ++day) {
                         if (day == currentDay) continue;
 
-                        // Calculate distances
-                        double oldDistance = route.totalDistance(depot);
-                        dailyRoutes[day].addDelivery(delivery);
-                        double newDistance = dailyRoutes[day].totalDistance(depot);
-
-                        double newTotalDistance = currentTotalDistance - oldDistance + newDistance;
+                        size_t position = 0;
+                        double newTotalDistance = totalAfterMove(delivery, day, currentTotalDistance - removedDistance, depot, &position);
 
-                        if (newTotalDistance < bestDistance) {
+                        // Strict improvement of the true total guarantees termination
+                        if (newTotalDistance < bestDistance - 1e-9) {
                             bestDay = day;
+                            bestPosition = position;
                             bestDistance = newTotalDistance;
                             changesMade = true;
                         }
+                    }
+
+                    // Move delivery to the best day
+                    if (bestDay != currentDay) {
+                        route.removeDelivery(delivery);
+                        getRoute(bestDay).insertDelivery(delivery, bestPosition);
+                        currentTotalDistance = bestDistance;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Optimize all routes like optimizeAllRoutes, evaluating only the most promising days exactly.
+     * 
+     * For every delivery the surrogate ranks the other days in its window by the length it
+     * would add there, from the straight-line distance to the day's nearest stop or the depot
+     * (see RouteLengthModel::insertionLength): a day with a stop at the same address ranks
+     * first at no cost, and empty days are scored by the exact round trip. The topK
+     * best-ranked days are evaluated exactly, and so is every further day whose estimate is
+     * within a factor (1 + ambiguity) of the last one kept, since the surrogate cannot tell
+     * those apart. Moves are still accepted only on a strict improvement of the exact total,
+     * so the total never increases; a topK at least the window length evaluates every
+     * candidate, like the full search.
+     * 
+     * @param depot The location of the depot.
+     * @param surrogate The route length model used for ranking.
+     * @param topK The number of candidate days evaluated exactly per delivery.
+     * @param ambiguity Relative margin of the estimates within which further days are evaluated exactly.
+     * @param stats Optional counters; in audit mode all candidates are evaluated to measure the screen.
+     */
+    void optimizeAllRoutes(const Address<T>& depot, const RouteLengthModel<T>& surrogate, size_t topK,
+                           double ambiguity = 0.25, ScreeningStats* stats = nullptr) {
+        const TravelCostModel<T>& costModel = getTravelCostModel();
+
+        // One grid over the stops of all days and the depot, about one cell per stop of an average day
+        double left = depot.getX(), right = depot.getX(), bottom = depot.getY(), top = depot.getY();
+        size_t stopCount = 0, routeCount = 0;
+        for (const auto& [day, route] : dailyRoutes) {
+            route.forEachStop([&](const typename Route<T>::Stop& stop) {
+                left = std::min(left, static_cast<double>(stop.location.getX()));
+                right = std::max(right, static_cast<double>(stop.location.getX()));
+                bottom = std::min(bottom, static_cast<double>(stop.location.getY()));
+                top = std::max(top, static_cast<double>(stop.location.getY()));
+            });
+            stopCount += route.numStops();
+            if (route.numStops() > 0) ++routeCount;
+        }
+        int cellsPerSide = static_cast<int>(std::ceil(std::sqrt(stopCount / std::max<double>(routeCount, 1.0))));
+        cellsPerSide = std::clamp(cellsPerSide, 1, 256);
+        double cellSize = std::max({right - left, top - bottom, 1e-9}) / cellsPerSide;
+
+        // Stops of every day, re-bucketed for the two days of each move
+        std::map<int, StopGrid<T>> grids;
+        auto regrid = [&](int day, const Route<T>& route) {
+            grids.try_emplace(day, left, bottom, cellSize, cellsPerSide).first->second.assign(route);
+        };
+        for (const auto& [day, route] : dailyRoutes) regrid(day, route);
+
+        double currentTotalDistance = calculateTotalDistance(depot);
+        std::vector<std::pair<double, int>> ranked;
+        bool changesMade = true;
+
+        while (changesMade) {
+            changesMade = false;
+
+            for (auto& [currentDay, route] : dailyRoutes) {
+                std::vector<DeliveryRequest<T>> deliveries = route.getDeliveries();
+
+                for (const auto& delivery : deliveries) {
+                    const Address<T>& location = delivery.getAddress();
+                    double baseDistance = currentTotalDistance - route.removalGain(delivery, depot, costModel);
+                    double dx = static_cast<double>(location.getX()) - depot.getX();
+                    double dy = static_cast<double>(location.getY()) - depot.getY();
+                    double depotDistance = std::sqrt(dx * dx + dy * dy);
+
+                    // Rank the candidate days by estimated added length
+                    ranked.clear();
+                    for (int day = delivery.getEarliestDeliveryDate(); day <= delivery.getLatestDeliveryDate(); ++day) {
+                        if (day == currentDay) continue;
+                        auto grid = grids.find(day);
+                        double estimate;
+                        if (grid == grids.end() || grid->second.size() == 0) {
+                            estimate = costModel.cost(depot, location) + costModel.cost(location, depot);
+                        } else {
+                            estimate = surrogate.insertionLength(std::min(grid->second.nearestDistance(location), depotDistance));
+                        }
+                        ranked.emplace_back(estimate, day);
+                    }
+                    std::sort(ranked.begin(), ranked.end());
 
-                        dailyRoutes[day].removeDelivery(delivery);
+                    // Enforced fallback: days ranked too close to the last kept one are evaluated as well
+                    size_t kept = std::min(topK, ranked.size());
+                    if (kept > 0) {
+                        double cutoff = ranked[kept - 1].first * (1.0 + ambiguity);
+                        size_t screened = kept;
+                        while (kept < ranked.size() && ranked[kept].first <= cutoff) ++kept;
+                        if (stats) stats->fallbackEvaluations += kept - screened;
+                    }
+
+                    // Evaluate the kept days in day order, as the full search does, so equal totals resolve alike
+                    std::sort(ranked.begin(), ranked.begin() + kept,
+                              [](const auto& a, const auto& b) { return a.second < b.second; });
+
+                    int bestDay = currentDay;
+                    size_t bestPosition = 0;
+                    double bestDistance = currentTotalDistance;
+                    for (size_t i = 0; i < kept; ++i) {
+                        size_t position = 0;
+                        double newTotalDistance = totalAfterMove(delivery, ranked[i].second, baseDistance, depot, &position);
+
+                        // Strict improvement of the true total guarantees termination
+                        if (newTotalDistance < bestDistance - 1e-9) {
+                            bestDay = ranked[i].second;
+                            bestPosition = position;
+                            bestDistance = newTotalDistance;
+                        }
+                    }
+
+                    if (stats) {
+                        stats->candidates += ranked.size();
+                        stats->exactEvaluations += kept;
+                        if (kept < ranked.size()) ++stats->decisions;
+                        if (stats->audit && kept < ranked.size()) {
+                            ++stats->auditedDecisions;
+                            double fullBest = bestDistance;
+                            for (size_t i = kept; i < ranked.size(); ++i) {
+                                fullBest = std::min(fullBest, totalAfterMove(delivery, ranked[i].second, baseDistance, depot));
+                            }
+                            double regret = fullBest < bestDistance - 1e-9 ? bestDistance - fullBest : 0.0;
+                            if (regret == 0.0) ++stats->hits;
+                            stats->totalRegret += regret;
+                            stats->maxRegret = std::max(stats->maxRegret, regret);
+                        }
                     }
 
                     // Move delivery to the best day
                     if (bestDay != currentDay) {
                         route.removeDelivery(delivery);
-                        dailyRoutes[bestDay].addDelivery(delivery);
+                        getRoute(bestDay).insertDelivery(delivery, bestPosition);
+                        regrid(currentDay, route);
+                        regrid(bestDay, getRoute(bestDay));
                         currentTotalDistance = bestDistance;
+                        changesMade = true;
                     }
                 }
             }
         }
     }
 
+    /**
+     * @brief Jointly minimize total distance and day-to-day load imbalance in one pass loop.
+     * 
+     * Minimizes total + lambda * N * sigma, where sigma is the standard deviation of the daily
+     * distances over the planning horizon of N days, so both terms share the scale of the
+     * total distance. Each candidate move (one delivery to its cheapest insertion on another
+     * day in its window) is scored by delta evaluation: the removal gain and insertion cost
+     * update the two affected day loads, and the running sum and sum of squares of the day
+     * loads give the new imbalance in constant time.
+     * 
+     * @param depot The location of the depot.
+     * @param lambda Weight of the load imbalance relative to the total distance.
+     * @param maxDayDistance Moves that would push a day beyond this distance are rejected.
+     * @param maxPasses The maximum number of passes over all deliveries.
+     * @return The number of passes performed.
+     */
+    int optimizeJoint(const Address<T>& depot, double lambda,
+                      double maxDayDistance = std::numeric_limits<double>::infinity(), int maxPasses = 100) {
+        const TravelCostModel<T>& costModel = getTravelCostModel();
+        auto [firstDay, lastDay] = planningHorizon();
+        if (firstDay > lastDay) return 0;
+        const double numDays = lastDay - firstDay + 1.0;
+
+        // Day-load aggregates, updated incrementally after every move
+        std::map<int, double> dayDistance;
+        double sum = 0.0, sumOfSquares = 0.0;
+        for (const auto& [day, route] : dailyRoutes) {
+            double distance = route.totalDistance(depot, costModel);
+            dayDistance[day] = distance;
+            sum += distance;
+            sumOfSquares += distance * distance;
+        }
+        auto objective = [&](double total, double squares) {
+            double variance = std::max(squares / numDays - (total / numDays) * (total / numDays), 0.0);
+            return total + lambda * numDays * std::sqrt(variance);
+        };
+
+        int passes = 0;
+        bool changesMade = true;
+        while (changesMade && passes < maxPasses) {
+            changesMade = false;
+            ++passes;
+
+            for (auto& [currentDay, route] : dailyRoutes) {
+                std::vector<DeliveryRequest<T>> deliveries = route.getDeliveries();
+
+                for (const auto& delivery : deliveries) {
+                    double currentObjective = objective(sum, sumOfSquares);
+                    double oldCurrent = dayDistance[currentDay];
+                    double newCurrent = oldCurrent - route.removalGain(delivery, depot, costModel);
+
+                    int bestDay = currentDay;
+                    size_t bestPosition = 0;
+                    double bestObjective = currentObjective - 1e-9;
+
+                    for (int day = delivery.getEarliestDeliveryDate(); day <= delivery.getLatestDeliveryDate(); ++day) {
+                        if (day == currentDay) continue;
+
+                        auto target = dailyRoutes.find(day);
+                        size_t position = 0;
+                        double insertion = target == dailyRoutes.end()
+                                               ? costModel.cost(depot, delivery.getAddress()) + costModel.cost(delivery.getAddress(), depot)
+                                               : target->second.insertionCost(delivery, depot, costModel, &position);
+                        double oldTarget = target == dailyRoutes.end() ? 0.0 : dayDistance[day];
+                        double newTarget = oldTarget + insertion;
+                        if (newTarget > maxDayDistance) continue;
+
+                        double newSum = sum - oldCurrent - oldTarget + newCurrent + newTarget;
+                        double newSquares = sumOfSquares - oldCurrent * oldCurrent - oldTarget * oldTarget
+                                            + newCurrent * newCurrent + newTarget * newTarget;
+                        double newObjective = objective(newSum, newSquares);
+                        if (newObjective < bestObjective) {
+                            bestObjective = newObjective;
+                            bestDay = day;
+                            bestPosition = position;
+                        }
+                    }
+
+                    if (bestDay != currentDay) {
+                        route.removeDelivery(delivery);
+                        Route<T>& targetRoute = getRoute(bestDay);
+                        targetRoute.insertDelivery(delivery, bestPosition);
+
+                        // Refresh the two affected loads exactly to avoid drift
+                        for (int day : {currentDay, bestDay}) {
+                            double oldDistance = dayDistance[day];
+                            double newDistance = getRoute(day).totalDistance(depot, costModel);
+                            dayDistance[day] = newDistance;
+                            sum += newDistance - oldDistance;
+                            sumOfSquares += newDistance * newDistance - oldDistance * oldDistance;
+                        }
+                        changesMade = true;
+                    }
+                }
+            }
+        }
+        return passes;
+    }
+
+    /**
+     * @brief Reorder the stops of every day into a shorter tour.
+     * 
+     * Days with at most the solver's exact stop limit are solved optimally, longer days
+     * are improved by 2-opt (see Route::optimizeStopOrder).
+     * 
+     * @param depot The location of the depot.
+     * @param solver The tour solver holding the exact stop limit and the cache.
+     * @return The total distance after reordering.
+     */
+    double optimizeStopOrder(const Address<T>& depot, TourSolver<T>& solver = defaultTourSolver<T>()) {
+        double totalDistance = 0.0;
+        for (auto& [day, route] : dailyRoutes) {
+            totalDistance += route.optimizeStopOrder(depot, getTravelCostModel(), solver);
+        }
+        return totalDistance;
+    }
+
     /**
      * @brief Calculate the total distance traveled across all routes.
      * 
@@ -141,11 +732,34 @@ public:
     double calculateTotalDistance(const Address<T>& depot) const {
         double totalDistance = 0.0;
         for (const auto& [day, route] : dailyRoutes) {
-            totalDistance += route.totalDistance(depot);
+            totalDistance += route.totalDistance(depot, getTravelCostModel());
         }
         return totalDistance;
     }
 
+    /**
+     * @brief Calculate the standard deviation of the daily distances over the planning horizon.
+     * 
+     * The planning horizon spans from the earliest to the latest delivery date of all
+     * scheduled deliveries; days without deliveries count as zero.
+     * 
+     * @param depot The location of the depot.
+     * @return The standard deviation of the daily distances.
+     */
+    double calculateLoadImbalance(const Address<T>& depot) const {
+        auto [firstDay, lastDay] = planningHorizon();
+        if (firstDay > lastDay) return 0.0;
+        const double numDays = lastDay - firstDay + 1.0;
+
+        double sum = 0.0, sumOfSquares = 0.0;
+        for (const auto& [day, route] : dailyRoutes) {
+            double distance = route.totalDistance(depot, getTravelCostModel());
+            sum += distance;
+            sumOfSquares += distance * distance;
+        }
+        return std::sqrt(std::max(sumOfSquares / numDays - (sum / numDays) * (sum / numDays), 0.0));
+    }
+
     /**
      * @brief Export the schedule to a CSV file.
      * 
@@ -164,8 +778,8 @@ public:
         double totalDistance = 0.0;
 
         for (const auto& [day, route] : dailyRoutes) {
-            int numDeliveries = route.getDeliveries().size();
-            double dailyDistance = route.totalDistance(depot);
+            int numDeliveries = static_cast<int>(route.size());
+            double dailyDistance = route.totalDistance(depot, getTravelCostModel());
             totalOrders += numDeliveries;
             totalDistance += dailyDistance;
 
@@ -175,6 +789,40 @@ public:
         outFile << "Total," << totalOrders << "," << totalDistance << "\n";
         outFile.close();
     }
+
+    /**
+     * @brief Export the full ordered stop sequence of every day to a CSV file.
+     * 
+     * @param depot The location of the depot.
+     * @param filename The name of the output file.
+     * @return True if the export succeeded.
+     */
+    bool exportRoutes(const Address<T>& depot, const std::string& filename) const {
+        RouteExporter<T> exporter(filename);
+        if (!exporter.isOpen()) return false;
+
+        for (const auto& [day, route] : dailyRoutes) {
+            exporter.writeRoute(day, 0, route, depot, getTravelCostModel());
+        }
+        return exporter.close();
+    }
+
+    /**
+     * @brief Stream the routes of all days up to a finalized day that were not yet written.
+     * 
+     * Call this whenever the schedule is frozen up to a day, then close the exporter once
+     * the last day is final.
+     * 
+     * @param exporter The exporter to write to.
+     * @param depot The location of the depot.
+     * @param finalizedDay The last day whose route will no longer change.
+     */
+    void streamFinalizedDays(RouteExporter<T>& exporter, const Address<T>& depot, int finalizedDay) {
+        for (auto it = dailyRoutes.upper_bound(lastStreamedDay); it != dailyRoutes.end() && it->first <= finalizedDay; ++it) {
+            exporter.writeRoute(it->first, 0, it->second, depot, getTravelCostModel());
+        }
+        lastStreamedDay = std::max(lastStreamedDay, finalizedDay);
+    }
 };
 
-#endif // SCHEDULEBALANCED_HPP
\ No newline at end of file
+#endif // SCHEDULEBALANCED_HPP
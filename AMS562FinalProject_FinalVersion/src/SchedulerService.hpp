@@ -0,0 +1,683 @@
+#ifndef SCHEDULERSERVICE_HPP
+#define SCHEDULERSERVICE_HPP
+
+#include "MpscQueue.hpp"
+#include "ScheduleBalanced.hpp"
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @enum MessageType
+ * @brief First byte of every protocol frame.
+ *
+ * Every frame is a uint32 payload length followed by the payload, all in host byte order
+ * (the socket is local). Requests and their replies:
+ * - Order: x, y (double), placement, earliest, latest (int32), prime (uint8) -> Ack
+ * - Cancel: order id (uint64) -> Ack
+ * - QueryDay: day (int32) -> DayRoutes: version (uint64), count (uint32), then per order
+ *   x, y, placement, earliest, latest, prime in visiting order
+ * - QuerySummary -> Summary: version (uint64), orders (uint64), total distance (double)
+ * - Ack: accepted (uint8), order id (uint64); orders with a day outside [0, SchedulerService::maxDay]
+ *   or a window longer than SchedulerService::maxWindowDays are rejected with accepted = 0 and id 0
+ */
+enum class MessageType : uint8_t {
+    Order = 'O',
+    Cancel = 'C',
+    QueryDay = 'Q',
+    QuerySummary = 'S',
+    Ack = 'A',
+    DayRoutes = 'D',
+    Summary = 'M'
+};
+
+/**
+ * @class WireBuffer
+ * @brief Builds and parses protocol payloads.
+ */
+class WireBuffer {
+private:
+    std::vector<char> bytes; ///< Payload bytes
+    size_t readPosition = 0; ///< Next byte to parse
+
+public:
+    /**
+     * @brief Append a trivially copyable value.
+     */
+    template <typename Value>
+    void put(const Value& value) {
+        const char* raw = reinterpret_cast<const char*>(&value);
+        bytes.insert(bytes.end(), raw, raw + sizeof(Value));
+    }
+
+    /**
+     * @brief Parse the next trivially copyable value.
+     *
+     * @return False if the payload is too short.
+     */
+    template <typename Value>
+    bool get(Value& value) {
+        if (readPosition + sizeof(Value) > bytes.size()) return false;
+        std::memcpy(&value, bytes.data() + readPosition, sizeof(Value));
+        readPosition += sizeof(Value);
+        return true;
+    }
+
+    /**
+     * @brief Send the payload as one length-prefixed frame.
+     *
+     * @param fd The connected socket.
+     * @return False if the connection failed.
+     */
+    bool send(int fd) const {
+        uint32_t length = static_cast<uint32_t>(bytes.size());
+        const char* prefix = reinterpret_cast<const char*>(&length);
+        std::vector<char> frame;
+        frame.reserve(sizeof(length) + bytes.size());
+        frame.insert(frame.end(), prefix, prefix + sizeof(length));
+        frame.insert(frame.end(), bytes.begin(), bytes.end());
+
+        size_t sent = 0;
+        while (sent < frame.size()) {
+            ssize_t result = ::send(fd, frame.data() + sent, frame.size() - sent, MSG_NOSIGNAL);
+            if (result <= 0) return false;
+            sent += static_cast<size_t>(result);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Replace the payload with the next frame from the socket.
+     *
+     * @param fd The connected socket.
+     * @return False if the connection closed or the frame is oversized.
+     */
+    bool receive(int fd) {
+        auto readFully = [fd](char* out, size_t count) {
+            size_t received = 0;
+            while (received < count) {
+                ssize_t result = ::recv(fd, out + received, count - received, 0);
+                if (result <= 0) return false;
+                received += static_cast<size_t>(result);
+            }
+            return true;
+        };
+
+        uint32_t length = 0;
+        if (!readFully(reinterpret_cast<char*>(&length), sizeof(length))) return false;
+        if (length > (1u << 24)) return false;
+        bytes.resize(length);
+        readPosition = 0;
+        return readFully(bytes.data(), length);
+    }
+};
+
+/**
+ * @struct ScheduleSnapshot
+ * @brief Immutable copy of the schedule that readers query while the optimizer keeps working.
+ *
+ * Days are shared between consecutive snapshots until their route changes, so publishing
+ * copies only the days a batch touched.
+ *
+ * @tparam T The type of the coordinates in the Address (e.g., int, float, double).
+ */
+template <typename T>
+struct ScheduleSnapshot {
+    /**
+     * @struct Day
+     * @brief Copy of one day's route.
+     */
+    struct Day {
+        uint64_t revision = 0; ///< Revision of the route this copy was taken from
+        double distance = 0.0; ///< Length of the route
+        std::vector<DeliveryRequest<T>> deliveries; ///< Orders in visiting order
+    };
+
+    uint64_t version = 0; ///< Number of batches applied before this snapshot
+    uint64_t numOrders = 0; ///< Number of scheduled orders
+    double totalDistance = 0.0; ///< Total distance of all routes
+    std::map<int, std::shared_ptr<const Day>> days; ///< Every day with orders
+};
+
+/**
+ * @class SchedulerService
+ * @brief Resident scheduler that takes orders, cancellations and queries over a Unix socket.
+ *
+ * Connection threads push orders and cancellations into a lock-free MPSC queue and acknowledge
+ * them right away. A single optimizer thread drains the queue in batches, applies them to a
+ * ScheduleBalanced (regret insertion for new orders, plus one pass of the joint optimizer
+ * whenever the queue is drained) and publishes an immutable snapshot. Queries are answered from the latest snapshot, so
+ * readers never wait for the optimizer. The accept thread joins the threads of disconnected
+ * clients, so a long-running service holds threads only for open connections.
+ *
+ * @tparam T The type of the coordinates in the Address (e.g., int, float, double).
+ */
+template <typename T>
+class SchedulerService {
+private:
+    /**
+     * @struct Command
+     * @brief An order or cancellation waiting for the optimizer thread.
+     */
+    struct Command {
+        uint64_t id = 0; ///< Order id
+        bool cancel = false; ///< True for a cancellation
+        std::optional<DeliveryRequest<T>> request; ///< The order (not set for cancellations)
+    };
+
+    /**
+     * @struct Connection
+     * @brief A client thread and the flag it raises when done.
+     */
+    struct Connection {
+        std::thread thread; ///< Serves the client
+        std::unique_ptr<std::atomic<bool>> finished; ///< Set by the thread just before it exits
+    };
+
+    Address<T> depot; ///< The depot location
+    double imbalanceWeight; ///< Weight of the load imbalance in the joint optimizer
+    size_t maxBatchSize; ///< Most commands applied per batch
+
+    ScheduleBalanced<T> schedule; ///< Live schedule, owned by the optimizer thread
+    std::unordered_map<uint64_t, DeliveryRequest<T>> orders; ///< Scheduled orders by id (optimizer thread)
+    MpscQueue<Command> intake; ///< Orders and cancellations from the connections
+    std::atomic<uint64_t> nextOrderId{1}; ///< Next id handed out on intake
+    std::shared_ptr<const ScheduleSnapshot<T>> snapshot; ///< Latest published schedule
+
+    int listenFd = -1; ///< Listening socket
+    std::string socketPath; ///< Filesystem path of the socket
+    std::atomic<bool> running{false}; ///< Cleared to stop all threads
+    std::thread acceptThread; ///< Accepts new connections
+    std::thread optimizerThread; ///< Applies batches and publishes snapshots
+    std::vector<Connection> connections; ///< Client threads not yet joined (accept thread, then stop)
+    std::atomic<size_t> numConnections{0}; ///< Size of connections after the last reaping
+
+    /**
+     * @brief Publish the live schedule as a new snapshot.
+     *
+     * Days whose route revision matches the previous snapshot are shared with it; only
+     * changed days are copied and measured.
+     */
+    void publish(uint64_t version) {
+        using Day = typename ScheduleSnapshot<T>::Day;
+        auto previous = getSnapshot();
+        auto next = std::make_shared<ScheduleSnapshot<T>>();
+        next->version = version;
+        for (const auto& [day, route] : schedule.getDailyRoutes()) {
+            if (route.size() == 0) continue;
+            auto it = previous->days.find(day);
+            std::shared_ptr<const Day> published;
+            if (it != previous->days.end() && it->second->revision == route.getRevision()) {
+                published = it->second;
+            } else {
+                published = std::make_shared<const Day>(Day{route.getRevision(),
+                                                             route.totalDistance(depot, schedule.getTravelCostModel()),
+                                                             route.getDeliveries()});
+            }
+            next->numOrders += route.size();
+            next->totalDistance += published->distance;
+            next->days.emplace_hint(next->days.end(), day, std::move(published));
+        }
+        std::atomic_store(&snapshot, std::shared_ptr<const ScheduleSnapshot<T>>(std::move(next)));
+    }
+
+    /**
+     * @brief Drain the intake queue in batches until stopped.
+     */
+    void runOptimizer() {
+        uint64_t version = getSnapshot()->version;
+        std::vector<Command> batch;
+        batch.reserve(maxBatchSize);
+
+        while (running.load(std::memory_order_acquire)) {
+            batch.clear();
+            Command command;
+            while (batch.size() < maxBatchSize && intake.pop(command)) batch.push_back(std::move(command));
+            if (batch.empty()) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                continue;
+            }
+
+            // Cancellations in the same batch annul their orders before anything is scheduled
+            std::unordered_set<uint64_t> cancelled;
+            for (const auto& item : batch) {
+                if (item.cancel) cancelled.insert(item.id);
+            }
+
+            std::vector<DeliveryRequest<T>> newOrders;
+            for (const auto& item : batch) {
+                if (item.cancel) continue;
+                if (cancelled.erase(item.id)) continue;
+                orders.emplace(item.id, *item.request);
+                newOrders.push_back(*item.request);
+            }
+            for (uint64_t id : cancelled) {
+                auto it = orders.find(id);
+                if (it == orders.end()) continue;
+                schedule.cancelDelivery(it->second);
+                orders.erase(it);
+            }
+
+            schedule.planRoutes(newOrders, depot, SeedingStrategy::RegretInsertion);
+
+            // Improve only once caught up, so a backlog is cleared at insertion speed
+            if (intake.empty()) {
+                schedule.optimizeJoint(depot, imbalanceWeight, std::numeric_limits<double>::infinity(), 1);
+            }
+            publish(++version);
+        }
+    }
+
+    /**
+     * @brief Check the dates of an incoming order.
+     *
+     * The optimizer visits every day of a window, so windows are bounded by maxWindowDays, and
+     * days by maxDay so that day loops and the Prime window (placement + 1) cannot overflow.
+     *
+     * @return True if every day lies in [0, maxDay] and the window is ordered and at most maxWindowDays long.
+     */
+    static bool isValidWindow(int32_t placement, int32_t earliest, int32_t latest) {
+        for (int32_t day : {placement, earliest, latest}) {
+            if (day < 0 || day > maxDay) return false;
+        }
+        return earliest <= latest && latest - earliest <= maxWindowDays;
+    }
+
+    /**
+     * @brief Answer one request frame.
+     *
+     * @return False if the request is malformed or the reply could not be sent.
+     */
+    bool handleRequest(int fd, WireBuffer& request) {
+        uint8_t type = 0;
+        if (!request.get(type)) return false;
+        WireBuffer reply;
+
+        switch (static_cast<MessageType>(type)) {
+            case MessageType::Order: {
+                double x, y;
+                int32_t placement, earliest, latest;
+                uint8_t prime;
+                if (!request.get(x) || !request.get(y) || !request.get(placement) || !request.get(earliest) ||
+                    !request.get(latest) || !request.get(prime)) {
+                    return false;
+                }
+                bool valid = isValidWindow(placement, earliest, latest);
+                uint64_t id = valid ? submitOrder(DeliveryRequest<T>(Address<T>(static_cast<T>(x), static_cast<T>(y)),
+                                                                     placement, earliest, latest, prime != 0))
+                                    : 0;
+                reply.put(static_cast<uint8_t>(MessageType::Ack));
+                reply.put(static_cast<uint8_t>(valid));
+                reply.put(id);
+                break;
+            }
+            case MessageType::Cancel: {
+                uint64_t id;
+                if (!request.get(id)) return false;
+                submitCancel(id);
+                reply.put(static_cast<uint8_t>(MessageType::Ack));
+                reply.put(static_cast<uint8_t>(1));
+                reply.put(id);
+                break;
+            }
+            case MessageType::QueryDay: {
+                int32_t day;
+                if (!request.get(day)) return false;
+                auto current = getSnapshot();
+                auto it = current->days.find(day);
+                uint32_t count = it == current->days.end() ? 0 : static_cast<uint32_t>(it->second->deliveries.size());
+                reply.put(static_cast<uint8_t>(MessageType::DayRoutes));
+                reply.put(current->version);
+                reply.put(count);
+                for (uint32_t i = 0; i < count; ++i) {
+                    const auto& delivery = it->second->deliveries[i];
+                    reply.put(static_cast<double>(delivery.getAddress().getX()));
+                    reply.put(static_cast<double>(delivery.getAddress().getY()));
+                    reply.put(static_cast<int32_t>(delivery.getPlacementDate()));
+                    reply.put(static_cast<int32_t>(delivery.getEarliestDeliveryDate()));
+                    reply.put(static_cast<int32_t>(delivery.getLatestDeliveryDate()));
+                    reply.put(static_cast<uint8_t>(delivery.getIsPrime()));
+                }
+                break;
+            }
+            case MessageType::QuerySummary: {
+                auto current = getSnapshot();
+                reply.put(static_cast<uint8_t>(MessageType::Summary));
+                reply.put(current->version);
+                reply.put(current->numOrders);
+                reply.put(current->totalDistance);
+                break;
+            }
+            default:
+                return false;
+        }
+        return reply.send(fd);
+    }
+
+    /**
+     * @brief Serve one client until it disconnects or the service stops.
+     */
+    void serveConnection(int fd, std::atomic<bool>* finished) {
+        WireBuffer request;
+        pollfd descriptor{fd, POLLIN, 0};
+        while (running.load(std::memory_order_acquire)) {
+            int ready = ::poll(&descriptor, 1, 100);
+            if (ready < 0) break;
+            if (ready == 0) continue;
+            if (!request.receive(fd) || !handleRequest(fd, request)) break;
+        }
+        ::close(fd);
+        finished->store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Join the threads of clients that have disconnected.
+     */
+    void reapConnections() {
+        for (size_t i = 0; i < connections.size();) {
+            if (!connections[i].finished->load(std::memory_order_acquire)) {
+                ++i;
+                continue;
+            }
+            connections[i].thread.join();
+            connections[i] = std::move(connections.back());
+            connections.pop_back();
+        }
+        numConnections.store(connections.size(), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Accept clients until the service stops, reaping finished client threads as it goes.
+     */
+    void acceptConnections() {
+        pollfd descriptor{listenFd, POLLIN, 0};
+        while (running.load(std::memory_order_acquire)) {
+            reapConnections();
+            if (::poll(&descriptor, 1, 100) <= 0) continue;
+            int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd < 0) continue;
+            Connection connection{std::thread(), std::make_unique<std::atomic<bool>>(false)};
+            connection.thread = std::thread(&SchedulerService::serveConnection, this, fd, connection.finished.get());
+            connections.push_back(std::move(connection));
+        }
+    }
+
+public:
+    static constexpr int maxWindowDays = 30; ///< Longest delivery window accepted at intake, in days
+    static constexpr int maxDay = 1000000; ///< Latest day accepted at intake, far below the int range
+
+    /**
+     * @brief Constructor.
+     *
+     * @param depotLocation The depot location.
+     * @param lambda Weight of the load imbalance in the joint optimizer.
+     * @param batchSize Most orders and cancellations applied per batch.
+     */
+    explicit SchedulerService(const Address<T>& depotLocation, double lambda = 0.5, size_t batchSize = 1024)
+        : depot(depotLocation), imbalanceWeight(lambda), maxBatchSize(batchSize),
+          snapshot(std::make_shared<const ScheduleSnapshot<T>>()) {}
+
+    SchedulerService(const SchedulerService&) = delete;
+    SchedulerService& operator=(const SchedulerService&) = delete;
+
+    ~SchedulerService() { stop(); }
+
+    /**
+     * @brief Set how close orders must be to share a stop. Call before preload and start.
+     *
+     * @param tolerance Grid size for merging; 0 merges identical addresses only, negative disables merging.
+     */
+    void setStopMergeTolerance(double tolerance) {
+        schedule.setStopMergeTolerance(tolerance);
+    }
+
+    /**
+     * @brief Schedule a set of orders before the service starts.
+     *
+     * @param deliveries The orders to schedule; they receive the first ids.
+     */
+    void preload(const std::vector<DeliveryRequest<T>>& deliveries) {
+        if (running) return;
+        for (const auto& delivery : deliveries) orders.emplace(nextOrderId++, delivery);
+        schedule.planRoutes(deliveries, depot, SeedingStrategy::RegretInsertion);
+        schedule.optimizeJoint(depot, imbalanceWeight);
+        publish(0);
+    }
+
+    /**
+     * @brief Listen on a Unix-domain socket and start the optimizer and accept threads.
+     *
+     * @param path Filesystem path of the socket; an existing file there is replaced.
+     * @return True if the service is listening.
+     */
+    bool start(const std::string& path) {
+        if (running) return false;
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) {
+            std::cerr << "Socket path too long: " << path << std::endl;
+            return false;
+        }
+
+        listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0) {
+            std::cerr << "Error creating socket." << std::endl;
+            return false;
+        }
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        ::unlink(path.c_str());
+        if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+            ::listen(listenFd, 64) < 0) {
+            std::cerr << "Error listening on socket: " << path << std::endl;
+            ::close(listenFd);
+            listenFd = -1;
+            return false;
+        }
+
+        socketPath = path;
+        running = true;
+        optimizerThread = std::thread(&SchedulerService::runOptimizer, this);
+        acceptThread = std::thread(&SchedulerService::acceptConnections, this);
+        return true;
+    }
+
+    /**
+     * @brief Stop all threads, close the socket and remove its file.
+     */
+    void stop() {
+        if (!running.exchange(false)) return;
+        acceptThread.join();
+        optimizerThread.join();
+        for (auto& connection : connections) connection.thread.join();
+        connections.clear();
+        numConnections = 0;
+        ::close(listenFd);
+        listenFd = -1;
+        ::unlink(socketPath.c_str());
+    }
+
+    /**
+     * @brief Queue an order for the optimizer thread. Safe to call from any thread.
+     *
+     * @param delivery The order.
+     * @return The id assigned to the order.
+     */
+    uint64_t submitOrder(const DeliveryRequest<T>& delivery) {
+        uint64_t id = nextOrderId.fetch_add(1, std::memory_order_relaxed);
+        intake.push(Command{id, false, delivery});
+        return id;
+    }
+
+    /**
+     * @brief Queue a cancellation for the optimizer thread. Safe to call from any thread.
+     *
+     * @param id The id of the order to cancel; unknown ids are ignored.
+     */
+    void submitCancel(uint64_t id) {
+        intake.push(Command{id, true, std::nullopt});
+    }
+
+    /**
+     * @brief Get the number of client threads the service holds.
+     *
+     * @return Open connections plus any closed within the last accept poll (100 ms).
+     */
+    size_t getNumConnections() const {
+        return numConnections.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the latest published schedule.
+     *
+     * @return The snapshot; it never changes once published.
+     */
+    std::shared_ptr<const ScheduleSnapshot<T>> getSnapshot() const {
+        return std::atomic_load(&snapshot);
+    }
+};
+
+/**
+ * @class SchedulerClient
+ * @brief Blocking client for the scheduler service protocol.
+ */
+class SchedulerClient {
+private:
+    int fd = -1; ///< Connected socket
+
+    bool exchange(const WireBuffer& request, WireBuffer& reply, MessageType expected) const {
+        if (fd < 0 || !request.send(fd) || !reply.receive(fd)) return false;
+        uint8_t type = 0;
+        return reply.get(type) && type == static_cast<uint8_t>(expected);
+    }
+
+public:
+    SchedulerClient() = default;
+    SchedulerClient(const SchedulerClient&) = delete;
+    SchedulerClient& operator=(const SchedulerClient&) = delete;
+
+    ~SchedulerClient() { disconnect(); }
+
+    /**
+     * @brief Connect to a running service.
+     *
+     * @param path Filesystem path of the service socket.
+     * @return True if connected.
+     */
+    bool connect(const std::string& path) {
+        disconnect();
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) return false;
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return false;
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            disconnect();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Close the connection.
+     */
+    void disconnect() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+    /**
+     * @brief Place an order.
+     *
+     * @param delivery The order.
+     * @param id Receives the id assigned by the service.
+     * @return True if the service accepted the order.
+     */
+    bool placeOrder(const DeliveryRequest<double>& delivery, uint64_t& id) const {
+        WireBuffer request, reply;
+        request.put(static_cast<uint8_t>(MessageType::Order));
+        request.put(delivery.getAddress().getX());
+        request.put(delivery.getAddress().getY());
+        request.put(static_cast<int32_t>(delivery.getPlacementDate()));
+        request.put(static_cast<int32_t>(delivery.getEarliestDeliveryDate()));
+        request.put(static_cast<int32_t>(delivery.getLatestDeliveryDate()));
+        request.put(static_cast<uint8_t>(delivery.getIsPrime()));
+        uint8_t accepted = 0;
+        return exchange(request, reply, MessageType::Ack) && reply.get(accepted) && reply.get(id) && accepted;
+    }
+
+    /**
+     * @brief Cancel an order.
+     *
+     * @param id The id of the order.
+     * @return True if the service queued the cancellation.
+     */
+    bool cancelOrder(uint64_t id) const {
+        WireBuffer request, reply;
+        request.put(static_cast<uint8_t>(MessageType::Cancel));
+        request.put(id);
+        uint8_t accepted = 0;
+        return exchange(request, reply, MessageType::Ack) && reply.get(accepted) && accepted;
+    }
+
+    /**
+     * @brief Get the orders of one day in visiting order.
+     *
+     * @param day The day.
+     * @param deliveries Receives the orders.
+     * @param version Receives the snapshot version the answer came from.
+     * @return True if the query succeeded.
+     */
+    bool queryDay(int day, std::vector<DeliveryRequest<double>>& deliveries, uint64_t& version) const {
+        WireBuffer request, reply;
+        request.put(static_cast<uint8_t>(MessageType::QueryDay));
+        request.put(static_cast<int32_t>(day));
+        uint32_t count = 0;
+        if (!exchange(request, reply, MessageType::DayRoutes) || !reply.get(version) || !reply.get(count)) return false;
+
+        deliveries.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            double x, y;
+            int32_t placement, earliest, latest;
+            uint8_t prime;
+            if (!reply.get(x) || !reply.get(y) || !reply.get(placement) || !reply.get(earliest) ||
+                !reply.get(latest) || !reply.get(prime)) {
+                return false;
+            }
+            deliveries.emplace_back(Address<double>(x, y), placement, earliest, latest, prime != 0);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Get the size and total distance of the current schedule.
+     *
+     * @param version Receives the snapshot version.
+     * @param numOrders Receives the number of scheduled orders.
+     * @param totalDistance Receives the total distance.
+     * @return True if the query succeeded.
+     */
+    bool querySummary(uint64_t& version, uint64_t& numOrders, double& totalDistance) const {
+        WireBuffer request, reply;
+        request.put(static_cast<uint8_t>(MessageType::QuerySummary));
+        return exchange(request, reply, MessageType::Summary) && reply.get(version) && reply.get(numOrders) &&
+               reply.get(totalDistance);
+    }
+};
+
+#endif // SCHEDULERSERVICE_HPP
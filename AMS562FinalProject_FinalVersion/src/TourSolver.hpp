@@ -0,0 +1,356 @@
+#ifndef TOURSOLVER_HPP
+#define TOURSOLVER_HPP
+
+#include "Address.hpp"
+#include "TravelCost.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class TourSolver
+ * @brief Orders the stops of a single depot tour, exactly for small tours and by 2-opt otherwise.
+ *
+ * The exact solver is Held–Karp dynamic programming over subsets of stops. States whose
+ * cost plus a lower bound on the remaining tour cannot beat the 2-opt tour are pruned.
+ * Exact results are cached by stop set and cost-model generation, so a day composition
+ * that reappears, even in another order, is solved only once, while a changed or new
+ * model never sees stale tours. Costs are assumed to be symmetric.
+ *
+ * @tparam T The type of the coordinates in the Address (e.g., int, float, double).
+ */
+template <typename T>
+class TourSolver {
+public:
+    /**
+     * @struct Tour
+     * @brief A tour that starts and ends at the depot.
+     */
+    struct Tour {
+        double cost = 0.0; ///< Total tour cost including both depot legs
+        std::vector<size_t> order; ///< Indices of the stops in visiting order
+    };
+
+    static constexpr size_t maxExactStops = 16; ///< Hard cap on the exact solver's size (DP table of 2^16 * 16 entries)
+
+private:
+    /**
+     * @struct CacheEntry
+     * @brief An exact tour stored in canonical (sorted) stop order.
+     */
+    struct CacheEntry {
+        uint64_t generation; ///< Generation of the cost model the tour was solved with
+        std::vector<double> coordinates; ///< Depot followed by the sorted stops, as x,y pairs
+        Tour tour; ///< Optimal tour over the sorted stops
+    };
+
+    static constexpr size_t retainedScratchStops = 12; ///< Largest solve whose DP tables stay allocated per thread
+
+    size_t exactStopLimit; ///< Tours with at most this many stops are solved exactly
+    size_t maxCacheEntries; ///< The cache is cleared once it holds this many entries
+    std::unordered_map<uint64_t, std::vector<CacheEntry>> cache; ///< Exact tours by stop-set hash
+    size_t cacheEntries = 0; ///< Number of cached tours
+    size_t cacheHits = 0; ///< Exact solves answered from the cache
+    size_t cacheMisses = 0; ///< Exact solves that ran the dynamic program
+    mutable std::mutex mutex; ///< Guards the cache and its counters
+
+    /**
+     * @brief Full cost matrix over the depot (index 0) and the stops (indices 1..n).
+     */
+    static std::vector<double> buildMatrix(const Address<T>& depot, const std::vector<Address<T>>& stops,
+                                           const TravelCostModel<T>& costModel) {
+        std::vector<Address<T>> points;
+        points.reserve(stops.size() + 1);
+        points.push_back(depot);
+        points.insert(points.end(), stops.begin(), stops.end());
+
+        const size_t size = points.size();
+        std::vector<std::vector<double>> rows = costModel.costMatrix(points, points);
+        std::vector<double> matrix(size * size);
+        for (size_t i = 0; i < size; ++i) {
+            std::copy(rows[i].begin(), rows[i].end(), matrix.begin() + i * size);
+        }
+        return matrix;
+    }
+
+    /**
+     * @brief 2-opt on a matrix tour, starting from the given stop order (stop i is matrix index i + 1).
+     */
+    static Tour twoOpt(const std::vector<double>& matrix, size_t n, std::vector<size_t> order) {
+        const size_t size = n + 1;
+        auto c = [&](size_t a, size_t b) { return matrix[a * size + b]; };
+
+        // Node sequence depot, stops..., depot
+        std::vector<size_t> tour(n + 2, 0);
+        for (size_t i = 0; i < n; ++i) tour[i + 1] = order[i] + 1;
+
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            for (size_t i = 1; i + 1 <= n; ++i) {
+                for (size_t j = i + 1; j <= n; ++j) {
+                    double delta = c(tour[i - 1], tour[j]) + c(tour[i], tour[j + 1])
+                                   - c(tour[i - 1], tour[i]) - c(tour[j], tour[j + 1]);
+                    if (delta < -1e-10) {
+                        std::reverse(tour.begin() + i, tour.begin() + j + 1);
+                        improved = true;
+                    }
+                }
+            }
+        }
+
+        Tour result;
+        for (size_t i = 1; i <= n; ++i) result.order.push_back(tour[i] - 1);
+        for (size_t i = 0; i + 1 < tour.size(); ++i) result.cost += c(tour[i], tour[i + 1]);
+        return result;
+    }
+
+    /**
+     * @brief Held–Karp over a matrix tour; returns the upper-bound tour if nothing beats it.
+     */
+    static Tour heldKarp(const std::vector<double>& matrix, size_t n, const Tour& upperBound) {
+        if (n <= 2) return upperBound; // Every order of two stops costs the same
+        const size_t size = n + 1;
+        auto c = [&](size_t a, size_t b) { return matrix[a * size + b]; };
+        const double infinity = std::numeric_limits<double>::infinity();
+
+        // Cheapest way into every node: a lower bound on each remaining leg
+        std::vector<double> minIn(size, infinity);
+        for (size_t to = 0; to < size; ++to) {
+            for (size_t from = 0; from < size; ++from) {
+                if (from != to) minIn[to] = std::min(minIn[to], c(from, to));
+            }
+        }
+
+        // dp[mask * n + j]: cheapest path from the depot through the stops in mask, ending at stop j.
+        // Scratch tables are reused across solves up to the default size and released above it.
+        thread_local std::vector<double> dp;
+        thread_local std::vector<uint8_t> parent;
+        struct ScratchRelease {
+            size_t n;
+            ~ScratchRelease() {
+                if (n > retainedScratchStops) {
+                    std::vector<double>().swap(dp);
+                    std::vector<uint8_t>().swap(parent);
+                }
+            }
+        } release{n};
+        const size_t numMasks = size_t(1) << n;
+        dp.assign(numMasks * n, infinity);
+        parent.resize(numMasks * n);
+        for (size_t j = 0; j < n; ++j) dp[(size_t(1) << j) * n + j] = c(0, j + 1);
+
+        const double bound = upperBound.cost - 1e-9;
+        for (size_t mask = 1; mask < numMasks; ++mask) {
+            double remaining = minIn[0];
+            for (size_t k = 0; k < n; ++k) {
+                if (!(mask & (size_t(1) << k))) remaining += minIn[k + 1];
+            }
+
+            for (size_t j = 0; j < n; ++j) {
+                double current = dp[mask * n + j];
+                if (current + remaining >= bound) continue; // Pruned, or unreachable
+
+                for (size_t k = 0; k < n; ++k) {
+                    size_t bit = size_t(1) << k;
+                    if (mask & bit) continue;
+                    size_t next = (mask | bit) * n + k;
+                    double candidate = current + c(j + 1, k + 1);
+                    if (candidate + remaining - minIn[k + 1] >= bound) continue;
+                    if (candidate < dp[next]) {
+                        dp[next] = candidate;
+                        parent[next] = static_cast<uint8_t>(j);
+                    }
+                }
+            }
+        }
+
+        const size_t full = numMasks - 1;
+        double bestCost = bound;
+        size_t last = n;
+        for (size_t j = 0; j < n; ++j) {
+            double candidate = dp[full * n + j] + c(j + 1, 0);
+            if (candidate < bestCost) {
+                bestCost = candidate;
+                last = j;
+            }
+        }
+        if (last == n) return upperBound;
+
+        Tour result;
+        result.cost = bestCost;
+        result.order.resize(n);
+        size_t mask = full;
+        for (size_t position = n; position-- > 0;) {
+            result.order[position] = last;
+            size_t previous = parent[mask * n + last];
+            mask &= ~(size_t(1) << last);
+            last = previous;
+        }
+        return result;
+    }
+
+    /**
+     * @brief FNV-1a hash over the coordinate bits and the cost model's generation.
+     */
+    static uint64_t hashCoordinates(const std::vector<double>& coordinates, uint64_t generation) {
+        uint64_t hash = (1469598103934665603ULL ^ generation) * 1099511628211ULL;
+        for (double value : coordinates) {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            hash = (hash ^ bits) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param exactLimit Tours with at most this many stops are solved exactly (capped at maxExactStops).
+     * @param cacheLimit The cache is cleared once it holds this many tours.
+     */
+    explicit TourSolver(size_t exactLimit = 12, size_t cacheLimit = 100000)
+        : exactStopLimit(std::min(exactLimit, maxExactStops)), maxCacheEntries(cacheLimit) {}
+
+    /**
+     * @brief Get the largest number of stops solved exactly.
+     *
+     * @return The exact stop limit.
+     */
+    size_t getExactStopLimit() const { return exactStopLimit; }
+
+    /**
+     * @brief Set the largest number of stops solved exactly.
+     *
+     * @param limit The exact stop limit (capped at maxExactStops).
+     */
+    void setExactStopLimit(size_t limit) { exactStopLimit = std::min(limit, maxExactStops); }
+
+    /**
+     * @brief Optimal tour through the stops, served from the cache when the stop set was seen before.
+     *
+     * @param depot The starting and ending location of the tour.
+     * @param stops The stop locations in their current order (at most maxExactStops).
+     * @param costModel The travel cost model.
+     * @return The optimal tour.
+     */
+    Tour solveExact(const Address<T>& depot, const std::vector<Address<T>>& stops,
+                    const TravelCostModel<T>& costModel = defaultTravelCost<T>()) {
+        const size_t n = stops.size();
+        if (n > maxExactStops) return improveTour(depot, stops, costModel);
+
+        // Canonical order makes the cache key independent of the current visiting order
+        std::vector<size_t> sorted(n);
+        std::iota(sorted.begin(), sorted.end(), 0);
+        std::sort(sorted.begin(), sorted.end(), [&](size_t a, size_t b) {
+            if (stops[a].getX() != stops[b].getX()) return stops[a].getX() < stops[b].getX();
+            return stops[a].getY() < stops[b].getY();
+        });
+        std::vector<double> coordinates;
+        coordinates.reserve(2 * n + 2);
+        coordinates.push_back(static_cast<double>(depot.getX()));
+        coordinates.push_back(static_cast<double>(depot.getY()));
+        for (size_t i : sorted) {
+            coordinates.push_back(static_cast<double>(stops[i].getX()));
+            coordinates.push_back(static_cast<double>(stops[i].getY()));
+        }
+        const uint64_t generation = costModel.getGeneration();
+        const uint64_t hash = hashCoordinates(coordinates, generation);
+
+        auto fromCanonical = [&](const Tour& canonical) {
+            Tour tour{canonical.cost, {}};
+            for (size_t i : canonical.order) tour.order.push_back(sorted[i]);
+            return tour;
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = cache.find(hash);
+            if (it != cache.end()) {
+                for (const auto& entry : it->second) {
+                    if (entry.generation == generation && entry.coordinates == coordinates) {
+                        ++cacheHits;
+                        return fromCanonical(entry.tour);
+                    }
+                }
+            }
+            ++cacheMisses;
+        }
+
+        // The current order, in canonical indices, seeds the 2-opt upper bound
+        std::vector<Address<T>> canonicalStops;
+        std::vector<size_t> current(n);
+        for (size_t i = 0; i < n; ++i) {
+            canonicalStops.push_back(stops[sorted[i]]);
+            current[sorted[i]] = i;
+        }
+
+        std::vector<double> matrix = buildMatrix(depot, canonicalStops, costModel);
+        Tour canonical = heldKarp(matrix, n, twoOpt(matrix, n, current));
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (cacheEntries >= maxCacheEntries) {
+                cache.clear();
+                cacheEntries = 0;
+            }
+            cache[hash].push_back({generation, std::move(coordinates), canonical});
+            ++cacheEntries;
+        }
+        return fromCanonical(canonical);
+    }
+
+    /**
+     * @brief Improve the current stop order with 2-opt.
+     *
+     * @param depot The starting and ending location of the tour.
+     * @param stops The stop locations in their current order.
+     * @param costModel The travel cost model.
+     * @return A tour no longer than the current order.
+     */
+    Tour improveTour(const Address<T>& depot, const std::vector<Address<T>>& stops,
+                     const TravelCostModel<T>& costModel = defaultTravelCost<T>()) const {
+        std::vector<size_t> order(stops.size());
+        std::iota(order.begin(), order.end(), 0);
+        return twoOpt(buildMatrix(depot, stops, costModel), stops.size(), order);
+    }
+
+    /**
+     * @brief Get the number of exact solves answered from the cache.
+     *
+     * @return The number of cache hits.
+     */
+    size_t getCacheHits() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return cacheHits;
+    }
+
+    /**
+     * @brief Get the number of exact solves that ran the dynamic program.
+     *
+     * @return The number of cache misses.
+     */
+    size_t getCacheMisses() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return cacheMisses;
+    }
+};
+
+/**
+ * @brief Shared tour solver with the default exact stop limit.
+ *
+ * @return A reference to the default tour solver.
+ */
+template <typename T>
+TourSolver<T>& defaultTourSolver() {
+    static TourSolver<T> solver;
+    return solver;
+}
+
+#endif // TOURSOLVER_HPP
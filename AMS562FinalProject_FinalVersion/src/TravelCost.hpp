@@ -0,0 +1,105 @@
+#ifndef TRAVELCOST_HPP
+#define TRAVELCOST_HPP
+
+#include "Address.hpp"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class TravelCostModel
+ * @brief Interface for the cost of travelling between two addresses.
+ *
+ * Routes and schedules ask the model for every leg they evaluate, so a model can
+ * replace straight-line distances with e.g. road-network travel costs. Every model
+ * carries a process-wide unique generation, renewed whenever its costs change, so
+ * caches keyed by it never serve results of another or an outdated model.
+ *
+ * @tparam T The type of the coordinates in the Address (e.g., int, float, double).
+ */
+template <typename T>
+class TravelCostModel {
+private:
+    uint64_t generation = nextGeneration(); ///< Identifies this model's current costs
+
+    static uint64_t nextGeneration() {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+protected:
+    /**
+     * @brief Mark the costs as changed; models call this whenever their costs change.
+     */
+    void invalidateCosts() {
+        generation = nextGeneration();
+    }
+
+public:
+    virtual ~TravelCostModel() = default;
+
+    /**
+     * @brief Identifier of the model's current costs, unique across all models in the process.
+     *
+     * @return The cost generation.
+     */
+    uint64_t getGeneration() const {
+        return generation;
+    }
+
+    /**
+     * @brief Cost of travelling from one address to another.
+     *
+     * @param from The start address.
+     * @param to The destination address.
+     * @return The travel cost.
+     */
+    virtual double cost(const Address<T>& from, const Address<T>& to) const = 0;
+
+    /**
+     * @brief Cost of travelling between every source and every target.
+     *
+     * Models with a faster batched query should override this.
+     *
+     * @param sources The start addresses.
+     * @param targets The destination addresses.
+     * @return A matrix where entry [i][j] is the cost from sources[i] to targets[j].
+     */
+    virtual std::vector<std::vector<double>> costMatrix(const std::vector<Address<T>>& sources,
+                                                        const std::vector<Address<T>>& targets) const {
+        std::vector<std::vector<double>> matrix(sources.size(), std::vector<double>(targets.size(), 0.0));
+        for (size_t i = 0; i < sources.size(); ++i) {
+            for (size_t j = 0; j < targets.size(); ++j) {
+                matrix[i][j] = cost(sources[i], targets[j]);
+            }
+        }
+        return matrix;
+    }
+};
+
+/**
+ * @class EuclideanCost
+ * @brief Straight-line travel cost, the default model.
+ *
+ * @tparam T The type of the coordinates in the Address (e.g., int, float, double).
+ */
+template <typename T>
+class EuclideanCost : public TravelCostModel<T> {
+public:
+    double cost(const Address<T>& from, const Address<T>& to) const override {
+        return from.distanceTo(to);
+    }
+};
+
+/**
+ * @brief Shared instance of the default (Euclidean) travel cost model.
+ *
+ * @return A reference to the default travel cost model.
+ */
+template <typename T>
+const TravelCostModel<T>& defaultTravelCost() {
+    static const EuclideanCost<T> model;
+    return model;
+}
+
+#endif // TRAVELCOST_HPP
@@ -0,0 +1,445 @@
+#ifndef ZONEDSCHEDULE_HPP
+#define ZONEDSCHEDULE_HPP
+
+#include "ScheduleBalanced.hpp"
+#include "TravelCost.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
+
+/**
+ * @enum ZoningMethod
+ * @brief How deliveries are partitioned into spatial zones.
+ */
+enum class ZoningMethod {
+    Sectors, ///< Equal-size angular sectors around the depot
+    KMeans ///< Capacitated k-means clusters
+};
+
+/**
+ * @class ZonedSchedule
+ * @brief Solves a large service area as independent spatial zones and stitches the results.
+ *
+ * Deliveries are partitioned into zones of bounded size, every zone is scheduled by its
+ * own ScheduleBalanced on a worker thread, and a boundary-repair pass then moves stops
+ * between neighboring zones on the same day. The zone routes of every day are then
+ * stitched into one route, so the result serves each day with a single vehicle like
+ * ScheduleBalanced, and the workload is balanced across days over the whole area.
+ *
+ * @tparam T The type of the coordinates in the Address (e.g., int, float, double).
+ */
+template <typename T>
+class ZonedSchedule {
+public:
+    /// Optimization applied to every zone after its routes are planned
+    using ZoneSolver = std::function<void(ScheduleBalanced<T>&, const Address<T>&)>;
+
+private:
+    ZoningMethod method; ///< Partitioning method
+    size_t maxZoneSize; ///< Maximum number of deliveries per zone
+    unsigned numThreads; ///< Number of worker threads solving zones
+    int kMeansIterations = 20; ///< Lloyd iterations for k-means zoning
+    size_t kMeansCandidates = 8; ///< Nearest centroids ranked per delivery in k-means zoning
+    std::shared_ptr<const TravelCostModel<T>> travelCost; ///< Travel cost model (Euclidean if null)
+    ZoneSolver zoneSolver; ///< Optimization applied to every zone
+    double stopMergeTolerance = 0.0; ///< Grid size within which orders share a stop in every zone
+    std::vector<ScheduleBalanced<T>> zones; ///< Schedule of every zone
+    ScheduleBalanced<T> stitched; ///< One route per day, stitched from the zone routes
+    std::vector<std::set<size_t>> neighbors; ///< Neighboring zones of every zone
+
+    const TravelCostModel<T>& getTravelCostModel() const {
+        return travelCost ? *travelCost : defaultTravelCost<T>();
+    }
+
+    /**
+     * @brief Split deliveries into contiguous angular sectors of equal size.
+     */
+    std::vector<size_t> sectorAssignment(const std::vector<DeliveryRequest<T>>& requests,
+                                         const Address<T>& depot, size_t numZones) const {
+        std::vector<size_t> order(requests.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::vector<double> angle(requests.size());
+        for (size_t i = 0; i < requests.size(); ++i) {
+            angle[i] = std::atan2(static_cast<double>(requests[i].getAddress().getY() - depot.getY()),
+                                  static_cast<double>(requests[i].getAddress().getX() - depot.getX()));
+        }
+        std::stable_sort(order.begin(), order.end(), [&angle](size_t a, size_t b) { return angle[a] < angle[b]; });
+
+        std::vector<size_t> zoneOf(requests.size(), 0);
+        for (size_t rank = 0; rank < order.size(); ++rank) {
+            zoneOf[order[rank]] = rank * numZones / order.size();
+        }
+        return zoneOf;
+    }
+
+    /**
+     * @brief Capacitated k-means seeded with the sector partition.
+     */
+    std::vector<size_t> kMeansAssignment(const std::vector<DeliveryRequest<T>>& requests,
+                                         const Address<T>& depot, size_t numZones) const {
+        std::vector<size_t> zoneOf = sectorAssignment(requests, depot, numZones);
+        size_t n = requests.size();
+        std::vector<double> x(n), y(n);
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = static_cast<double>(requests[i].getAddress().getX());
+            y[i] = static_cast<double>(requests[i].getAddress().getY());
+        }
+
+        std::vector<double> centerX(numZones, 0.0), centerY(numZones, 0.0);
+        size_t numCandidates = std::min(numZones, kMeansCandidates);
+        std::vector<std::pair<double, size_t>> ranked(n * numCandidates); ///< Nearest centroids per delivery
+        std::vector<std::pair<double, size_t>> distances(numZones);
+
+        for (int iteration = 0; iteration < kMeansIterations; ++iteration) {
+            // Update centroids
+            std::vector<double> sumX(numZones, 0.0), sumY(numZones, 0.0);
+            std::vector<size_t> count(numZones, 0);
+            for (size_t i = 0; i < n; ++i) {
+                sumX[zoneOf[i]] += x[i];
+                sumY[zoneOf[i]] += y[i];
+                ++count[zoneOf[i]];
+            }
+            for (size_t z = 0; z < numZones; ++z) {
+                if (count[z] == 0) continue;
+                centerX[z] = sumX[z] / count[z];
+                centerY[z] = sumY[z] / count[z];
+            }
+
+            auto squaredDistance = [&](size_t i, size_t z) {
+                return (x[i] - centerX[z]) * (x[i] - centerX[z]) + (y[i] - centerY[z]) * (y[i] - centerY[z]);
+            };
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t z = 0; z < numZones; ++z) distances[z] = {squaredDistance(i, z), z};
+                std::partial_sort(distances.begin(), distances.begin() + numCandidates, distances.end());
+                std::copy(distances.begin(), distances.begin() + numCandidates, ranked.begin() + i * numCandidates);
+            }
+
+            // Assign deliveries to the nearest centroid with remaining capacity, most constrained first
+            std::vector<size_t> order(n);
+            std::iota(order.begin(), order.end(), 0);
+            std::vector<double> regret(n, 0.0);
+            if (numCandidates > 1) {
+                for (size_t i = 0; i < n; ++i) regret[i] = ranked[i * numCandidates + 1].first - ranked[i * numCandidates].first;
+            }
+            std::stable_sort(order.begin(), order.end(), [&regret](size_t a, size_t b) { return regret[a] > regret[b]; });
+
+            std::vector<size_t> load(numZones, 0);
+            std::vector<size_t> next(n);
+            for (size_t i : order) {
+                // Only the nearest candidates are ranked; scan all zones if they are full
+                size_t best = numZones;
+                for (size_t c = 0; c < numCandidates && best == numZones; ++c) {
+                    size_t z = ranked[i * numCandidates + c].second;
+                    if (load[z] < maxZoneSize) best = z;
+                }
+                if (best == numZones) {
+                    double bestDistance = std::numeric_limits<double>::infinity();
+                    for (size_t z = 0; z < numZones; ++z) {
+                        if (load[z] < maxZoneSize && squaredDistance(i, z) < bestDistance) {
+                            bestDistance = squaredDistance(i, z);
+                            best = z;
+                        }
+                    }
+                }
+                next[i] = best;
+                ++load[best];
+            }
+
+            bool changed = next != zoneOf;
+            zoneOf = next;
+            if (!changed) break;
+        }
+        return zoneOf;
+    }
+
+public:
+    /**
+     * @brief Constructor to configure the decomposition.
+     *
+     * @param zoning The partitioning method.
+     * @param maxDeliveriesPerZone The maximum number of deliveries per zone.
+     * @param threads The number of worker threads (0 uses the hardware concurrency).
+     */
+    ZonedSchedule(ZoningMethod zoning = ZoningMethod::Sectors, size_t maxDeliveriesPerZone = 500, unsigned threads = 0)
+        : method(zoning), maxZoneSize(std::max<size_t>(maxDeliveriesPerZone, 1)),
+          numThreads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+        zoneSolver = [](ScheduleBalanced<T>& schedule, const Address<T>& depot) {
+            schedule.optimizeAllRoutes(depot);
+        };
+    }
+
+    /**
+     * @brief Set the travel cost model used by every zone.
+     *
+     * @param model The travel cost model, or nullptr to use straight-line distances.
+     */
+    void setTravelCostModel(std::shared_ptr<const TravelCostModel<T>> model) {
+        travelCost = std::move(model);
+    }
+
+    /**
+     * @brief Set how close orders must be to share a stop, in every zone.
+     *
+     * @param tolerance Grid size for merging; 0 merges identical addresses only, negative disables merging.
+     */
+    void setStopMergeTolerance(double tolerance) {
+        stopMergeTolerance = tolerance;
+    }
+
+    /**
+     * @brief Set the optimization applied to every zone after its routes are planned.
+     *
+     * @param solver The zone optimization.
+     */
+    void setZoneSolver(ZoneSolver solver) {
+        zoneSolver = std::move(solver);
+    }
+
+    /**
+     * @brief Partition deliveries into spatial zones of bounded size.
+     *
+     * @param requests The delivery requests to partition.
+     * @param depot The location of the depot.
+     * @return The zone index of every delivery request.
+     */
+    std::vector<size_t> partition(const std::vector<DeliveryRequest<T>>& requests, const Address<T>& depot) const {
+        if (requests.empty()) return {};
+        size_t numZones = (requests.size() + maxZoneSize - 1) / maxZoneSize;
+        if (method == ZoningMethod::KMeans) return kMeansAssignment(requests, depot, numZones);
+        return sectorAssignment(requests, depot, numZones);
+    }
+
+    /**
+     * @brief Partition, solve every zone in parallel, repair the zone boundaries and stitch the zones.
+     *
+     * After stitching, the workload is balanced across days and every day's stops are
+     * reordered into one tour (see stitchZones).
+     *
+     * @param requests The delivery requests to schedule.
+     * @param depot The location of the depot.
+     */
+    void solve(const std::vector<DeliveryRequest<T>>& requests, const Address<T>& depot) {
+        std::vector<size_t> zoneOf = partition(requests, depot);
+        size_t numZones = zoneOf.empty() ? 0 : *std::max_element(zoneOf.begin(), zoneOf.end()) + 1;
+
+        std::vector<std::vector<DeliveryRequest<T>>> zoneRequests(numZones);
+        for (size_t i = 0; i < requests.size(); ++i) {
+            zoneRequests[zoneOf[i]].push_back(requests[i]);
+        }
+
+        // Zones are neighbors if their members are closest to each other's centroid
+        std::vector<double> centerX(numZones, 0.0), centerY(numZones, 0.0);
+        for (size_t z = 0; z < numZones; ++z) {
+            for (const auto& delivery : zoneRequests[z]) {
+                centerX[z] += static_cast<double>(delivery.getAddress().getX()) / zoneRequests[z].size();
+                centerY[z] += static_cast<double>(delivery.getAddress().getY()) / zoneRequests[z].size();
+            }
+        }
+        neighbors.assign(numZones, {});
+        for (size_t i = 0; i < requests.size(); ++i) {
+            size_t own = zoneOf[i], closest = own;
+            double closestDistance = std::numeric_limits<double>::infinity();
+            for (size_t z = 0; z < numZones; ++z) {
+                if (z == own) continue;
+                double dx = static_cast<double>(requests[i].getAddress().getX()) - centerX[z];
+                double dy = static_cast<double>(requests[i].getAddress().getY()) - centerY[z];
+                if (dx * dx + dy * dy < closestDistance) {
+                    closestDistance = dx * dx + dy * dy;
+                    closest = z;
+                }
+            }
+            if (closest != own) {
+                neighbors[own].insert(closest);
+                neighbors[closest].insert(own);
+            }
+        }
+
+        zones.assign(numZones, ScheduleBalanced<T>());
+        std::atomic<size_t> nextZone{0};
+        auto worker = [&]() {
+            for (size_t z = nextZone++; z < numZones; z = nextZone++) {
+                zones[z].setTravelCostModel(travelCost);
+                zones[z].setStopMergeTolerance(stopMergeTolerance);
+                zones[z].planRoutes(zoneRequests[z]);
+                zoneSolver(zones[z], depot);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        unsigned threadCount = std::min<unsigned>(numThreads, static_cast<unsigned>(numZones));
+        for (unsigned t = 1; t < threadCount; ++t) workers.emplace_back(worker);
+        worker();
+        for (auto& thread : workers) thread.join();
+
+        repairBoundaries(depot);
+
+        // Sweep the zones around the depot so consecutive zone routes lie next to each other
+        std::vector<size_t> sweep(numZones);
+        std::iota(sweep.begin(), sweep.end(), 0);
+        std::vector<double> angle(numZones);
+        for (size_t z = 0; z < numZones; ++z) {
+            angle[z] = std::atan2(centerY[z] - static_cast<double>(depot.getY()), centerX[z] - static_cast<double>(depot.getX()));
+        }
+        std::stable_sort(sweep.begin(), sweep.end(), [&angle](size_t a, size_t b) { return angle[a] < angle[b]; });
+
+        stitchZones(sweep);
+        stitched.balanceWorkload(depot);
+        stitched.optimizeStopOrder(depot);
+    }
+
+    /**
+     * @brief Join the zone routes of every day into one route.
+     *
+     * Each day's route visits the zones' stops zone after zone in the given order, so it is
+     * never longer than the zone routes together; the depot returns between zones are dropped.
+     *
+     * @param zoneOrder The order in which the zones are visited.
+     */
+    void stitchZones(const std::vector<size_t>& zoneOrder) {
+        stitched = ScheduleBalanced<T>();
+        stitched.setTravelCostModel(travelCost);
+        stitched.setStopMergeTolerance(stopMergeTolerance);
+        for (size_t z : zoneOrder) {
+            for (const auto& [day, route] : zones[z].getDailyRoutes()) {
+                if (route.size() == 0) continue;
+                Route<T>& target = stitched.getRoute(day);
+                route.forEachDelivery([&target](const DeliveryRequest<T>& delivery) { target.addDelivery(delivery); });
+            }
+        }
+    }
+
+    /**
+     * @brief Move stops between neighboring zones on the same day while that shortens the zone routes.
+     *
+     * Works on the zone routes; call stitchZones afterwards to refresh the stitched schedule.
+     *
+     * @param depot The location of the depot.
+     * @param maxPasses The maximum number of improvement passes.
+     * @return The number of stops moved.
+     */
+    int repairBoundaries(const Address<T>& depot, int maxPasses = 10) {
+        const TravelCostModel<T>& costModel = getTravelCostModel();
+        int moves = 0;
+        bool changesMade = true;
+
+        for (int pass = 0; pass < maxPasses && changesMade; ++pass) {
+            changesMade = false;
+            for (size_t z = 0; z < zones.size(); ++z) {
+                std::vector<int> days;
+                for (const auto& [day, route] : zones[z].getDailyRoutes()) days.push_back(day);
+
+                for (int day : days) {
+                    Route<T>& route = zones[z].getRoute(day);
+                    for (const auto& delivery : route.getDeliveries()) {
+                        double gain = route.removalGain(delivery, depot, costModel);
+                        size_t bestZone = z, bestPosition = 0;
+                        double bestCost = gain;
+
+                        for (size_t neighbor : neighbors[z]) {
+                            size_t position = 0;
+                            const auto& neighborRoutes = zones[neighbor].getDailyRoutes();
+                            auto it = neighborRoutes.find(day);
+                            double cost = it == neighborRoutes.end()
+                                              ? 2.0 * costModel.cost(depot, delivery.getAddress())
+                                              : it->second.insertionCost(delivery, depot, costModel, &position);
+                            if (cost < bestCost - 1e-9) {
+                                bestCost = cost;
+                                bestZone = neighbor;
+                                bestPosition = position;
+                            }
+                        }
+
+                        if (bestZone != z) {
+                            route.removeDelivery(delivery);
+                            zones[bestZone].getRoute(day).insertDelivery(delivery, bestPosition);
+                            ++moves;
+                            changesMade = true;
+                        }
+                    }
+                }
+            }
+        }
+        return moves;
+    }
+
+    /**
+     * @brief Calculate the total distance of the stitched schedule.
+     *
+     * @param depot The location of the depot.
+     * @return The total distance traveled.
+     */
+    double calculateTotalDistance(const Address<T>& depot) const {
+        return stitched.calculateTotalDistance(depot);
+    }
+
+    /**
+     * @brief Calculate the total distance of the zone routes, one vehicle per zone and day.
+     *
+     * @param depot The location of the depot.
+     * @return The summed distance of all zone routes.
+     */
+    double calculateZoneDistance(const Address<T>& depot) const {
+        double totalDistance = 0.0;
+        for (const auto& zone : zones) {
+            totalDistance += zone.calculateTotalDistance(depot);
+        }
+        return totalDistance;
+    }
+
+    /**
+     * @brief Get the stitched schedule, one route per day.
+     *
+     * @return The stitched schedule.
+     */
+    const ScheduleBalanced<T>& getSchedule() const {
+        return stitched;
+    }
+
+    /**
+     * @brief Get the schedule of every zone.
+     *
+     * @return The zone schedules.
+     */
+    const std::vector<ScheduleBalanced<T>>& getZones() const {
+        return zones;
+    }
+
+    /**
+     * @brief Get the neighboring zones of every zone.
+     *
+     * @return The zone adjacency.
+     */
+    const std::vector<std::set<size_t>>& getNeighbors() const {
+        return neighbors;
+    }
+
+    /**
+     * @brief Export the stitched schedule to a CSV file, one row per day.
+     *
+     * @param depot The location of the depot.
+     * @param filename The name of the output file.
+     */
+    void exportData(const Address<T>& depot, const std::string& filename) const {
+        stitched.exportData(depot, filename);
+    }
+
+    /**
+     * @brief Export the full ordered stop sequence of every day of the stitched schedule to a CSV file.
+     *
+     * @param depot The location of the depot.
+     * @param filename The name of the output file.
+     * @return True if the export succeeded.
+     */
+    bool exportRoutes(const Address<T>& depot, const std::string& filename) const {
+        return stitched.exportRoutes(depot, filename);
+    }
+};
+
+#endif // ZONEDSCHEDULE_HPP
@@ -0,0 +1,50 @@
+#include "Address.hpp"
+#include "BenchmarkUtil.hpp"
+#include "DeliveryRequest.hpp"
+#include "ScheduleBalanced.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief Benchmark stop consolidation as the order density grows.
+ *
+ * For every scale factor given on the command line (default 1 5 10), the same orders are
+ * seeded by regret insertion and improved by the joint optimizer with merging disabled,
+ * with identical addresses merged, and with addresses on a 0.15 grid merged.
+ *
+ * @return Exit code (0 for success).
+ */
+int main(int argc, char* argv[]) {
+    std::vector<int> scales;
+    for (int i = 1; i < argc; ++i) scales.push_back(std::atoi(argv[i]));
+    if (scales.empty()) scales = {1, 5, 10};
+
+    Address<double> depot(0.0, 0.0);
+    const std::vector<double> tolerances = {-1.0, 0.0, 0.15};
+
+    std::cout << "Orders,MergeTolerance,Stops,Passes,Time,TotalDistance,Speedup\n";
+    for (int scale : scales) {
+        auto deliveries = generateDeliveries(scale);
+        double baseTime = 0.0;
+
+        for (double tolerance : tolerances) {
+            auto start = std::chrono::steady_clock::now();
+            ScheduleBalanced<double> schedule;
+            schedule.setStopMergeTolerance(tolerance);
+            schedule.planRoutes(deliveries, depot, SeedingStrategy::RegretInsertion);
+            int passes = schedule.optimizeJoint(depot, 0.5);
+            double time = secondsSince(start);
+            if (tolerance < 0.0) baseTime = time;
+
+            size_t stops = 0;
+            for (const auto& [day, route] : schedule.getDailyRoutes()) stops += route.numStops();
+            std::cout << deliveries.size() << "," << (tolerance < 0.0 ? "off" : std::to_string(tolerance)) << ","
+                      << stops << "," << passes << "," << time << "," << schedule.calculateTotalDistance(depot) << ","
+                      << baseTime / time << "x" << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "Address.hpp"
+#include "BenchmarkUtil.hpp"
+#include "DeliveryRequest.hpp"
+#include "ScheduleBalanced.hpp"
+#include "ZonedSchedule.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Benchmark the zoned decomposition against the monolithic schedule.
+ *
+ * For every scale factor given on the command line (default 1 2 5 10), the monolithic
+ * schedule and both zoning methods run the same plan/optimize/balance/reorder pipeline on
+ * generated orders, and both produce one vehicle route per day: the zoned schedules
+ * optimize the zones in parallel, then stitch each day's zone routes before balancing and
+ * reordering. The time ratio relative to the first scale shows whether the cost grows
+ * linearly with the number of orders.
+ *
+ * @return Exit code (0 for success).
+ */
+int main(int argc, char* argv[]) {
+    std::vector<int> scales;
+    for (int i = 1; i < argc; ++i) scales.push_back(std::atoi(argv[i]));
+    if (scales.empty()) scales = {1, 2, 5, 10};
+
+    Address<double> depot(0.0, 0.0);
+    double baseMonolithic = 0.0, baseSectors = 0.0, baseKMeans = 0.0;
+
+    std::cout << "Worker threads: " << std::max(1u, std::thread::hardware_concurrency()) << "\n";
+    std::cout << "Orders,MonolithicTime,MonolithicDistance,SectorsTime,SectorsDistance,"
+              << "KMeansTime,KMeansDistance,Zones,MonolithicGrowth,SectorsGrowth,KMeansGrowth\n";
+    for (int scale : scales) {
+        auto deliveries = generateDeliveries(scale);
+
+        auto start = std::chrono::steady_clock::now();
+        ScheduleBalanced<double> monolithic;
+        monolithic.planRoutes(deliveries);
+        monolithic.optimizeAllRoutes(depot);
+        monolithic.balanceWorkload(depot);
+        monolithic.optimizeStopOrder(depot);
+        double monolithicTime = secondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        ZonedSchedule<double> sectors(ZoningMethod::Sectors, 500);
+        sectors.solve(deliveries, depot);
+        double sectorsTime = secondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        ZonedSchedule<double> kMeans(ZoningMethod::KMeans, 500);
+        kMeans.solve(deliveries, depot);
+        double kMeansTime = secondsSince(start);
+
+        if (baseMonolithic == 0.0) {
+            baseMonolithic = monolithicTime;
+            baseSectors = sectorsTime;
+            baseKMeans = kMeansTime;
+        }
+
+        std::cout << deliveries.size() << ","
+                  << monolithicTime << "," << monolithic.calculateTotalDistance(depot) << ","
+                  << sectorsTime << "," << sectors.calculateTotalDistance(depot) << ","
+                  << kMeansTime << "," << kMeans.calculateTotalDistance(depot) << ","
+                  << sectors.getZones().size() << ","
+                  << monolithicTime / baseMonolithic << "x,"
+                  << sectorsTime / baseSectors << "x,"
+                  << kMeansTime / baseKMeans << "x" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "Address.hpp"
+#include "BenchmarkUtil.hpp"
+#include "DeliveryRequest.hpp"
+#include "Route.hpp"
+#include "RouteExporter.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Benchmark full-route export of a large schedule.
+ *
+ * Generates a schedule with the given number of stops (default one million) spread over
+ * 360 days and writes the full stop sequence twice: once through std::ofstream with
+ * default stream formatting, and once through RouteExporter.
+ *
+ * @return Exit code (0 for success).
+ */
+int main(int argc, char* argv[]) {
+    size_t numStops = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000; ///< Number of stops to export
+    const int numDays = 360;
+    std::mt19937 rng(562);
+    std::uniform_int_distribution<int> coordinate(0, 40);
+
+    std::vector<Route<double>> routes(numDays);
+    for (size_t i = 0; i < numStops; ++i) {
+        int day = static_cast<int>(i % numDays) + 1;
+        Address<double> customer(coordinate(rng) / 10.0, coordinate(rng) / 10.0);
+        routes[day - 1].addDelivery(DeliveryRequest<double>(customer, day - 3, day, day + 4, i % 6 == 0));
+    }
+    Address<double> depot(0.0, 0.0);
+
+    // Stream formatting through std::ofstream
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::ofstream outFile("benchmark_export_ofstream.csv");
+        outFile << "Day,Vehicle,Stop,X,Y,PlacementDate,EarliestDeliveryDate,LatestDeliveryDate,IsPrime,CumulativeDistance\n";
+        for (int day = 1; day <= numDays; ++day) {
+            double cumulative = 0.0;
+            int stop = 0;
+            Address<double> currentLocation = depot;
+            for (const auto& delivery : routes[day - 1].getDeliveries()) {
+                cumulative += currentLocation.distanceTo(delivery.getAddress());
+                currentLocation = delivery.getAddress();
+                outFile << day << ",0," << ++stop << "," << delivery.getAddress().getX() << ","
+                        << delivery.getAddress().getY() << "," << delivery.getPlacementDate() << ","
+                        << delivery.getEarliestDeliveryDate() << "," << delivery.getLatestDeliveryDate() << ","
+                        << (delivery.getIsPrime() ? 1 : 0) << "," << cumulative << "\n";
+            }
+        }
+    }
+    double streamTime = secondsSince(start);
+
+    // Buffered to_chars formatting with a background writer
+    start = std::chrono::steady_clock::now();
+    {
+        RouteExporter<double> exporter("benchmark_export_buffered.csv");
+        for (int day = 1; day <= numDays; ++day) {
+            exporter.writeRoute(day, 0, routes[day - 1], depot);
+        }
+        exporter.close();
+    }
+    double bufferedTime = secondsSince(start);
+
+    std::cout << "Stops: " << numStops << "\n";
+    std::cout << "std::ofstream: " << streamTime << " s\n";
+    std::cout << "RouteExporter: " << bufferedTime << " s (" << streamTime / bufferedTime << "x faster)\n";
+
+    std::remove("benchmark_export_ofstream.csv");
+    std::remove("benchmark_export_buffered.csv");
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "Address.hpp"
+#include "BenchmarkUtil.hpp"
+#include "DeliveryLoader.hpp"
+#include "DeliveryRequest.hpp"
+#include "ScheduleBalanced.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Longest daily distance of a schedule.
+ */
+static double maxDayDistance(const ScheduleBalanced<double>& schedule, const Address<double>& depot) {
+    double longest = 0.0;
+    for (const auto& [day, route] : schedule.getDailyRoutes()) {
+        longest = std::max(longest, route.totalDistance(depot));
+    }
+    return longest;
+}
+
+/**
+ * @brief Compare the two-phase pipeline with the joint optimizer over a sweep of lambda.
+ *
+ * The two-phase run optimizes distance first and then balances the workload. The joint
+ * runs minimize total distance + lambda * days * load standard deviation in one loop.
+ * Every row reports total distance, load standard deviation, the longest day and the time.
+ *
+ * @return Exit code (0 for success).
+ */
+int main(int argc, char* argv[]) {
+    const std::string inputFile = argc > 1 ? argv[1] : "data/randomized_data_large.csv";
+    std::vector<double> lambdas;
+    for (int i = 2; i < argc; ++i) lambdas.push_back(std::atof(argv[i]));
+    if (lambdas.empty()) lambdas = {0.0, 0.05, 0.1, 0.25, 0.5, 1.0};
+
+    std::vector<DeliveryRequest<double>> regularDeliveries, primeDeliveries;
+    loadDeliveriesFromCSV(inputFile, regularDeliveries, primeDeliveries);
+    if (regularDeliveries.empty() && primeDeliveries.empty()) return 1;
+    Address<double> depot(0.0, 0.0);
+
+    std::cout << "Method,Lambda,TotalDistance,LoadStdDev,MaxDay,Passes,Time\n";
+
+    auto start = std::chrono::steady_clock::now();
+    ScheduleBalanced<double> twoPhase;
+    twoPhase.planRoutes(regularDeliveries);
+    twoPhase.planRoutes(primeDeliveries);
+    twoPhase.optimizeAllRoutes(depot);
+    twoPhase.balanceWorkload(depot);
+    double twoPhaseTime = secondsSince(start);
+    std::cout << "TwoPhase,," << twoPhase.calculateTotalDistance(depot) << ","
+              << twoPhase.calculateLoadImbalance(depot) << "," << maxDayDistance(twoPhase, depot)
+              << ",," << twoPhaseTime << std::endl;
+
+    for (double lambda : lambdas) {
+        start = std::chrono::steady_clock::now();
+        ScheduleBalanced<double> joint;
+        joint.planRoutes(regularDeliveries);
+        joint.planRoutes(primeDeliveries);
+        int passes = joint.optimizeJoint(depot, lambda);
+        double jointTime = secondsSince(start);
+        std::cout << "Joint," << lambda << "," << joint.calculateTotalDistance(depot) << ","
+                  << joint.calculateLoadImbalance(depot) << "," << maxDayDistance(joint, depot)
+                  << "," << passes << "," << jointTime << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "Address.hpp"
+#include "BenchmarkUtil.hpp"
+#include "DeliveryRequest.hpp"
+#include "Route.hpp"
+#include "RoadNetworkCost.hpp"
+#include "DeliveryLoader.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Plain Dijkstra over the generated grid, used to verify hierarchy queries.
+ */
+static double referenceDijkstra(const std::vector<std::vector<std::pair<int, double>>>& adjacency, int source, int target) {
+    std::vector<double> dist(adjacency.size(), std::numeric_limits<double>::infinity());
+    using Item = std::pair<double, int>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+    dist[source] = 0.0;
+    queue.push({0.0, source});
+    while (!queue.empty()) {
+        auto [d, u] = queue.top();
+        queue.pop();
+        if (u == target) return d;
+        if (d > dist[u]) continue;
+        for (const auto& [v, w] : adjacency[u]) {
+            if (d + w < dist[v]) {
+                dist[v] = d + w;
+                queue.push({dist[v], v});
+            }
+        }
+    }
+    return dist[target];
+}
+
+/**
+ * @brief Benchmark road-graph preprocessing and travel-cost queries.
+ *
+ * Builds a synthetic road grid covering the delivery area (side length given as the
+ * first argument, default 60), then times contraction-hierarchy preprocessing,
+ * point-to-point queries against plain Dijkstra, many-to-many matrices, and full
+ * route evaluations over the large dataset with and without the cache warmed.
+ *
+ * @return Exit code (0 for success, non-zero if a query disagrees with Dijkstra).
+ */
+int main(int argc, char* argv[]) {
+    int side = argc > 1 ? std::atoi(argv[1]) : 60; ///< Grid nodes per axis
+    std::mt19937 rng(562);
+    std::uniform_real_distribution<double> detour(1.0, 1.6);
+    std::uniform_real_distribution<double> keep(0.0, 1.0);
+
+    // Generate a grid road network over [0, 4] x [0, 4] with random detours and missing roads
+    RoadNetworkCost<double> network;
+    std::vector<std::vector<std::pair<int, double>>> adjacency(side * side);
+    double spacing = 4.0 / (side - 1);
+    for (int j = 0; j < side; ++j) {
+        for (int i = 0; i < side; ++i) {
+            network.addNode(i * spacing, j * spacing);
+        }
+    }
+    auto connect = [&](int a, int b) {
+        if (keep(rng) < 0.1) return;
+        double cost = spacing * detour(rng);
+        network.addEdge(a, b, cost);
+        adjacency[a].push_back({b, cost});
+        adjacency[b].push_back({a, cost});
+    };
+    for (int j = 0; j < side; ++j) {
+        for (int i = 0; i < side; ++i) {
+            int node = j * side + i;
+            if (i + 1 < side) connect(node, node + 1);
+            if (j + 1 < side) connect(node, node + side);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    network.build();
+    double buildTime = secondsSince(start);
+    std::cout << "Preprocessing: " << side * side << " nodes, "
+              << network.getHierarchy().getNumShortcuts() << " shortcuts, "
+              << buildTime << " s\n";
+
+    // Point-to-point queries against plain Dijkstra
+    const int numQueries = 500;
+    std::uniform_int_distribution<int> pickNode(0, side * side - 1);
+    std::vector<std::pair<int, int>> pairs;
+    for (int q = 0; q < numQueries; ++q) pairs.push_back({pickNode(rng), pickNode(rng)});
+
+    start = std::chrono::steady_clock::now();
+    std::vector<double> chResults;
+    for (const auto& [s, t] : pairs) chResults.push_back(network.getHierarchy().query(s, t));
+    double chTime = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    int mismatches = 0;
+    for (size_t q = 0; q < pairs.size(); ++q) {
+        double expected = referenceDijkstra(adjacency, pairs[q].first, pairs[q].second);
+        if (std::abs(expected - chResults[q]) > 1e-9 && !(std::isinf(expected) && std::isinf(chResults[q]))) ++mismatches;
+    }
+    double dijkstraTime = secondsSince(start);
+    std::cout << "Point-to-point: " << numQueries << " queries, hierarchy "
+              << chTime * 1e6 / numQueries << " us/query, Dijkstra "
+              << dijkstraTime * 1e6 / numQueries << " us/query, mismatches " << mismatches << "\n";
+
+    // Many-to-many matrix over delivery-like points
+    std::uniform_int_distribution<int> gridCoordinate(0, 40);
+    std::vector<Address<double>> points;
+    for (int i = 0; i < 100; ++i) points.emplace_back(gridCoordinate(rng) / 10.0, gridCoordinate(rng) / 10.0);
+    start = std::chrono::steady_clock::now();
+    auto matrix = network.costMatrix(points, points);
+    double matrixTime = secondsSince(start);
+    std::cout << "Many-to-many: " << points.size() << "x" << points.size() << " matrix, "
+              << matrixTime << " s\n";
+
+    // Route evaluations as the optimizers perform them
+    std::vector<DeliveryRequest<double>> regularDeliveries, primeDeliveries;
+    loadDeliveriesFromCSV("data/randomized_data_large.csv", regularDeliveries, primeDeliveries);
+    Address<double> depot(0.0, 0.0);
+    std::vector<Route<double>> routes(64);
+    for (size_t i = 0; i < regularDeliveries.size(); ++i) routes[i % routes.size()].addDelivery(regularDeliveries[i]);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        start = std::chrono::steady_clock::now();
+        double total = 0.0;
+        for (const auto& route : routes) total += route.totalDistance(depot, network);
+        std::cout << "Route evaluation (" << (pass == 0 ? "cold" : "warm") << " cache): "
+                  << regularDeliveries.size() << " stops, road " << total << ", "
+                  << secondsSince(start) << " s\n";
+    }
+
+    start = std::chrono::steady_clock::now();
+    double euclidean = 0.0;
+    for (const auto& route : routes) euclidean += route.totalDistance(depot);
+    std::cout << "Route evaluation (Euclidean): straight-line " << euclidean << ", "
+              << secondsSince(start) << " s\n";
+    std::cout << "Cache hits " << network.getCacheHits() << ", misses " << network.getCacheMisses() << "\n";
+
+    return mismatches == 0 ? 0 : 1;
+}
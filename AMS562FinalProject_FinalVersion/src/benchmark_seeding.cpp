@@ -0,0 +1,67 @@
+#include "Address.hpp"
+#include "BenchmarkUtil.hpp"
+#include "DeliveryLoader.hpp"
+#include "DeliveryRequest.hpp"
+#include "ScheduleBalanced.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Compare seeding strategies by the work left to the optimizers.
+ *
+ * Every strategy seeds the combined regular and Prime schedule, which is then improved
+ * by the two-phase pipeline (optimizeAllRoutes, balanceWorkload) and, separately, by
+ * the joint optimizer. Rows report the seed quality and the time spent after seeding.
+ *
+ * @return Exit code (0 for success).
+ */
+int main(int argc, char* argv[]) {
+    const std::string inputFile = argc > 1 ? argv[1] : "data/randomized_data_large.csv";
+    const double imbalanceWeight = argc > 2 ? std::atof(argv[2]) : 0.5;
+    const double overloadPenalty = argc > 3 ? std::atof(argv[3]) : 1.0;
+
+    std::vector<DeliveryRequest<double>> regularDeliveries, primeDeliveries;
+    loadDeliveriesFromCSV(inputFile, regularDeliveries, primeDeliveries);
+    if (regularDeliveries.empty() && primeDeliveries.empty()) return 1;
+    Address<double> depot(0.0, 0.0);
+
+    const std::vector<std::pair<std::string, SeedingStrategy>> strategies = {
+        {"EarliestDay", SeedingStrategy::EarliestDay},
+        {"LocationClusters", SeedingStrategy::LocationClusters},
+        {"RegretInsertion", SeedingStrategy::RegretInsertion},
+    };
+
+    std::cout << "Strategy,SeedTime,SeedDistance,SeedStdDev,TwoPhaseTime,TwoPhaseDistance,"
+              << "JointTime,JointPasses,JointDistance,JointStdDev\n";
+    for (const auto& [name, strategy] : strategies) {
+        auto start = std::chrono::steady_clock::now();
+        ScheduleBalanced<double> seeded;
+        seeded.setSeedingParameters(0.5, overloadPenalty);
+        seeded.planRoutes(primeDeliveries, depot, strategy);
+        seeded.planRoutes(regularDeliveries, depot, strategy);
+        double seedTime = secondsSince(start);
+
+        ScheduleBalanced<double> twoPhase = seeded;
+        start = std::chrono::steady_clock::now();
+        twoPhase.optimizeAllRoutes(depot);
+        twoPhase.balanceWorkload(depot);
+        double twoPhaseTime = secondsSince(start);
+
+        ScheduleBalanced<double> joint = seeded;
+        start = std::chrono::steady_clock::now();
+        int passes = joint.optimizeJoint(depot, imbalanceWeight);
+        double jointTime = secondsSince(start);
+
+        std::cout << name << "," << seedTime << "," << seeded.calculateTotalDistance(depot) << ","
+                  << seeded.calculateLoadImbalance(depot) << ","
+                  << twoPhaseTime << "," << twoPhase.calculateTotalDistance(depot) << ","
+                  << jointTime << "," << passes << "," << joint.calculateTotalDistance(depot) << ","
+                  << joint.calculateLoadImbalance(depot) << std::endl;
+    }
+
+    return 0;
+}
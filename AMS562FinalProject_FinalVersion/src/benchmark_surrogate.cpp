@@ -0,0 +1,94 @@
+#include "Address.hpp"
+#include "BenchmarkUtil.hpp"
+#include "DeliveryRequest.hpp"
+#include "RouteLengthModel.hpp"
+#include "ScheduleBalanced.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Compare optimizeAllRoutes with and without surrogate screening of candidate days.
+ *
+ * For every scale factor given on the command line (default 1 5 10), orders are seeded on
+ * their earliest day and the route length model is calibrated on the seeded schedule,
+ * unless `--model <file>` names a model file (written by RouteLengthModel::save) to use for
+ * every scale instead; which model was used is printed with its coefficients. The full
+ * search then runs once and the screened search once per top-k (1, 2, 3), with days
+ * estimated within 25% of the last kept one evaluated as well: timed, and again in audit
+ * mode to measure how often the exact best day survived the screen and how much distance
+ * the screened-out days would have saved.
+ *
+ * Usage: `benchmark_surrogate [--model <file>] [scale ...]`.
+ *
+ * @return Exit code (0 for success).
+ */
+int main(int argc, char* argv[]) {
+    std::vector<int> scales;
+    std::string modelFile;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument == "--model" && i + 1 < argc) {
+            modelFile = argv[++i];
+        } else if (std::atoi(argv[i]) >= 1) {
+            scales.push_back(std::atoi(argv[i]));
+        } else {
+            std::cerr << "Usage: benchmark_surrogate [--model <file>] [scale >= 1 ...]" << std::endl;
+            return 1;
+        }
+    }
+    if (scales.empty()) scales = {1, 5, 10};
+
+    RouteLengthModel<double> loaded;
+    if (!modelFile.empty() && !loaded.load(modelFile)) return 1;
+
+    Address<double> depot(0.0, 0.0);
+    const std::vector<size_t> topKs = {1, 2, 3};
+    const double ambiguity = 0.25;
+
+    std::cout << "Orders,TopK,TotalDistance,QualityLoss,Time,Speedup,ExactShare,HitRate,MeanRegret,MaxRegret\n";
+    for (int scale : scales) {
+        auto deliveries = generateDeliveries(scale);
+        ScheduleBalanced<double> seeded;
+        seeded.planRoutes(deliveries);
+
+        RouteLengthModel<double> model = loaded;
+        std::string source = "loaded from " + modelFile;
+        if (modelFile.empty()) {
+            source = model.calibrate(seeded.getDailyRoutes(), depot) ? "calibrated" : "uncalibrated defaults";
+        }
+        std::cerr << "Orders " << deliveries.size() << ", model " << source << ": length ~ " << model.getAreaCoefficient()
+                  << " * sqrt(n * A) + " << model.getStopCoefficient() << " * n + " << model.getIntercept() << "\n";
+
+        auto start = std::chrono::steady_clock::now();
+        ScheduleBalanced<double> full = seeded;
+        full.optimizeAllRoutes(depot);
+        double fullTime = secondsSince(start);
+        double fullDistance = full.calculateTotalDistance(depot);
+        std::cout << deliveries.size() << ",all," << fullDistance << ",0%," << fullTime << ",1x,1,1,0,0" << std::endl;
+
+        for (size_t topK : topKs) {
+            ScreeningStats stats;
+            start = std::chrono::steady_clock::now();
+            ScheduleBalanced<double> screened = seeded;
+            screened.optimizeAllRoutes(depot, model, topK, ambiguity, &stats);
+            double time = secondsSince(start);
+            double distance = screened.calculateTotalDistance(depot);
+
+            ScreeningStats audit;
+            audit.audit = true;
+            ScheduleBalanced<double> audited = seeded;
+            audited.optimizeAllRoutes(depot, model, topK, ambiguity, &audit);
+
+            std::cout << deliveries.size() << "," << topK << "," << distance << ","
+                      << (distance - fullDistance) / fullDistance * 100.0 << "%," << time << "," << fullTime / time << "x,"
+                      << static_cast<double>(stats.exactEvaluations) / std::max<size_t>(stats.candidates, 1) << ","
+                      << audit.hitRate() << "," << audit.meanRegret() << ","
+                      << audit.maxRegret << std::endl;
+        }
+    }
+
+    return 0;
+}
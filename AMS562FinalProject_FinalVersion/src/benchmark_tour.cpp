@@ -0,0 +1,73 @@
+#include "Address.hpp"
+#include "BenchmarkUtil.hpp"
+#include "DeliveryLoader.hpp"
+#include "DeliveryRequest.hpp"
+#include "ScheduleBalanced.hpp"
+#include "TourSolver.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Compare stop ordering with 2-opt only against exact solves below growing stop limits.
+ *
+ * The combined schedule is seeded and jointly optimized as in the main program; every
+ * day is then reordered with each exact stop limit given on the command line (default
+ * 0 8 12 16; 0 means 2-opt only). A second reordering pass shows the cache at work.
+ *
+ * @return Exit code (0 for success).
+ */
+int main(int argc, char* argv[]) {
+    const std::string inputFile = argc > 1 ? argv[1] : "data/randomized_data_large.csv";
+    std::vector<size_t> limits;
+    for (int i = 2; i < argc; ++i) limits.push_back(std::strtoul(argv[i], nullptr, 10));
+    if (limits.empty()) limits = {0, 8, 12, 16};
+
+    std::vector<DeliveryRequest<double>> regularDeliveries, primeDeliveries;
+    loadDeliveriesFromCSV(inputFile, regularDeliveries, primeDeliveries);
+    if (regularDeliveries.empty() && primeDeliveries.empty()) return 1;
+    Address<double> depot(0.0, 0.0);
+
+    ScheduleBalanced<double> planned;
+    planned.planRoutes(primeDeliveries, depot, SeedingStrategy::RegretInsertion);
+    planned.planRoutes(regularDeliveries, depot, SeedingStrategy::RegretInsertion);
+    planned.optimizeJoint(depot, 0.5);
+
+    size_t days = 0, largestDay = 0, totalStops = 0;
+    for (const auto& [day, route] : planned.getDailyRoutes()) {
+        ++days;
+        totalStops += route.numStops();
+        largestDay = std::max(largestDay, route.numStops());
+    }
+    std::cout << "Days: " << days << ", stops per day: " << static_cast<double>(totalStops) / days
+              << " average, " << largestDay << " max\n";
+    std::cout << "Before reordering: " << planned.calculateTotalDistance(depot) << "\n";
+
+    std::cout << "ExactLimit,ExactDays,TotalDistance,Time,CachedTime,CacheHits,CacheMisses\n";
+    for (size_t limit : limits) {
+        TourSolver<double> solver(limit);
+        size_t exactDays = 0;
+        for (const auto& [day, route] : planned.getDailyRoutes()) {
+            if (route.numStops() >= 3 && route.numStops() <= solver.getExactStopLimit()) ++exactDays;
+        }
+
+        ScheduleBalanced<double> schedule = planned;
+        auto start = std::chrono::steady_clock::now();
+        double total = schedule.optimizeStopOrder(depot, solver);
+        double time = secondsSince(start);
+
+        // Same day compositions again, as the inter-day optimizers produce them
+        ScheduleBalanced<double> again = planned;
+        start = std::chrono::steady_clock::now();
+        again.optimizeStopOrder(depot, solver);
+        double cachedTime = secondsSince(start);
+
+        std::cout << solver.getExactStopLimit() << "," << exactDays << "," << total << "," << time << ","
+                  << cachedTime << "," << solver.getCacheHits() << "," << solver.getCacheMisses() << std::endl;
+    }
+
+    return 0;
+}
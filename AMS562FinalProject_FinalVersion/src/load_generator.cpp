@@ -0,0 +1,139 @@
+#include "DeliveryRequest.hpp"
+#include "SchedulerService.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @struct ClientResult
+ * @brief Latencies measured by one connection, in microseconds.
+ */
+struct ClientResult {
+    std::vector<double> orders; ///< Order acknowledgement latencies
+    std::vector<double> cancels; ///< Cancellation acknowledgement latencies
+    std::vector<double> queries; ///< Day query latencies
+    size_t failures = 0; ///< Requests that failed
+};
+
+/**
+ * @brief Send orders at a fixed rate, with a query every 10th and a cancellation every 20th tick.
+ *
+ * Every request of a tick is due at the tick's scheduled time, and all latencies run from
+ * that time to the reply, so a stalled service is not hidden by the client falling behind.
+ */
+static void runClient(const std::string& socketPath, double ratePerSecond, double seconds, unsigned seed,
+                      ClientResult& result) {
+    SchedulerClient client;
+    if (!client.connect(socketPath)) {
+        ++result.failures;
+        return;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> coordinate(0, 40);
+    std::uniform_int_distribution<int> day(1, 360);
+    std::vector<uint64_t> placed;
+    std::vector<DeliveryRequest<double>> dayOrders;
+
+    const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / ratePerSecond));
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    auto scheduled = start;
+
+    for (size_t tick = 1; scheduled < end; ++tick, scheduled += interval) {
+        std::this_thread::sleep_until(scheduled);
+
+        uint64_t id = 0;
+        int placement = day(rng);
+        bool ok = client.placeOrder(DeliveryRequest<double>(Address<double>(coordinate(rng) / 10.0, coordinate(rng) / 10.0),
+                                                            placement, placement + 3, placement + 7, tick % 9 == 0),
+                                    id);
+        auto sinceScheduled = [&scheduled]() {
+            return std::chrono::duration<double, std::micro>(Clock::now() - scheduled).count();
+        };
+        result.orders.push_back(sinceScheduled());
+        if (!ok) ++result.failures;
+        placed.push_back(id);
+
+        if (tick % 10 == 0) {
+            uint64_t version = 0;
+            if (!client.queryDay(day(rng), dayOrders, version)) ++result.failures;
+            result.queries.push_back(sinceScheduled());
+        }
+        if (tick % 20 == 0) {
+            if (!client.cancelOrder(placed[rng() % placed.size()])) ++result.failures;
+            result.cancels.push_back(sinceScheduled());
+        }
+    }
+}
+
+/**
+ * @brief Print count, p50, p99 and maximum of a latency sample.
+ */
+static void report(const std::string& name, std::vector<double> latencies) {
+    if (latencies.empty()) return;
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+    std::cout << name << "," << latencies.size() << "," << percentile(0.50) << "," << percentile(0.99) << ","
+              << latencies.back() << "\n";
+}
+
+/**
+ * @brief Load generator for the scheduler service.
+ *
+ * Usage: `load_generator [socket path] [orders per second] [seconds] [connections]`.
+ * Reports p50/p99 latencies per request type, all measured from the scheduled send time, and
+ * the final schedule summary.
+ *
+ * @return Exit code (0 for success).
+ */
+int main(int argc, char* argv[]) {
+    const std::string socketPath = argc > 1 ? argv[1] : "/tmp/delivery_scheduler.sock";
+    const double rate = argc > 2 ? std::atof(argv[2]) : 1000.0;
+    const double seconds = argc > 3 ? std::atof(argv[3]) : 5.0;
+    const int connections = argc > 4 ? std::atoi(argv[4]) : 4;
+    if (rate <= 0.0 || seconds <= 0.0 || connections < 1) {
+        std::cerr << "Usage: load_generator [socket path] [orders per second > 0] [seconds > 0] [connections >= 1]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::vector<ClientResult> results(connections);
+    std::vector<std::thread> clients;
+    for (int i = 0; i < connections; ++i) {
+        clients.emplace_back(runClient, socketPath, rate / connections, seconds, 562 + i, std::ref(results[i]));
+    }
+    for (auto& client : clients) client.join();
+
+    ClientResult all;
+    for (const auto& result : results) {
+        all.orders.insert(all.orders.end(), result.orders.begin(), result.orders.end());
+        all.cancels.insert(all.cancels.end(), result.cancels.begin(), result.cancels.end());
+        all.queries.insert(all.queries.end(), result.queries.begin(), result.queries.end());
+        all.failures += result.failures;
+    }
+
+    std::cout << "Target rate: " << rate << " orders/s over " << connections << " connections for "
+              << seconds << " s\n";
+    std::cout << "Request,Count,P50us,P99us,MaxUs\n";
+    report("Order", all.orders);
+    report("Cancel", all.cancels);
+    report("QueryDay", all.queries);
+    std::cout << "Failures: " << all.failures << "\n";
+
+    SchedulerClient client;
+    uint64_t version = 0, numOrders = 0;
+    double totalDistance = 0.0;
+    if (client.connect(socketPath) && client.querySummary(version, numOrders, totalDistance)) {
+        std::cout << "Schedule: version " << version << ", " << numOrders << " orders, total distance "
+                  << totalDistance << std::endl;
+    }
+    return all.failures == 0 ? 0 : 1;
+}
@@ -2,72 +2,12 @@
 #include "DeliveryRequest.hpp"
 #include "Route.hpp"
 #include "ScheduleBalanced.hpp"
+#include "RoadNetworkCost.hpp"
+#include "DeliveryLoader.hpp"
 #include <vector>
-#include <fstream>
-#include <sstream>
+#include <memory>
 #include <iostream>
 
-/**
- * @brief Helper function to load delivery requests from a CSV file.
- * 
- * @param filename The name of the input CSV file.
- * @param regularDeliveries A vector to store regular delivery requests.
- * @param primeDeliveries A vector to store Prime delivery requests.
- */
-void loadDeliveriesFromCSV(
-    const std::string& filename,
-    std::vector<DeliveryRequest<double>>& regularDeliveries,
-    std::vector<DeliveryRequest<double>>& primeDeliveries) {
-    std::ifstream inFile(filename);
-    if (!inFile.is_open()) {
-        std::cerr << "Error opening input file: " << filename << std::endl;
-        return;
-    }
-
-    std::string line;
-    // Skip the header
-    std::getline(inFile, line);
-
-    while (std::getline(inFile, line)) {
-        std::istringstream ss(line);
-        std::string value;
-        double x, y;
-        int placementDate, earliest, latest;
-        bool isPrime;
-
-        // Parse values from the CSV
-        std::getline(ss, value, ',');
-        x = std::stod(value);
-
-        std::getline(ss, value, ',');
-        y = std::stod(value);
-
-        std::getline(ss, value, ',');
-        placementDate = std::stoi(value);
-
-        std::getline(ss, value, ',');
-        earliest = std::stoi(value);
-
-        std::getline(ss, value, ',');
-        latest = std::stoi(value);
-
-        std::getline(ss, value, ',');
-        isPrime = (value == "1");
-
-        Address<double> customer(x, y);
-        DeliveryRequest<double> delivery(customer, placementDate, earliest, latest, isPrime);
-
-        // Separate into regular and Prime deliveries
-        if (isPrime) {
-            primeDeliveries.push_back(delivery);
-        } else {
-            regularDeliveries.push_back(delivery);
-        }
-    }
-
-    inFile.close();
-}
-
 /**
  * @brief Main function to schedule and balance deliveries using input data.
  * 
@@ -75,11 +15,22 @@ void loadDeliveriesFromCSV(
  * (regular and Prime deliveries), and schedules and balances the deliveries. The results 
  * are exported to separate CSV files for analysis.
  * 
+ * Optionally, a road graph can be given as `<nodes.csv> <edges.csv>` to use road travel
+ * costs instead of straight-line distances.
+ * 
  * @return Exit code (0 for success).
  */
-int main() {
+int main(int argc, char* argv[]) {
     Address<double> depot(0.0, 0.0); ///< The depot location
 
+    std::shared_ptr<RoadNetworkCost<double>> roadNetwork; ///< Road travel costs (straight-line if null)
+    if (argc >= 3) {
+        roadNetwork = std::make_shared<RoadNetworkCost<double>>();
+        if (!roadNetwork->loadFromCSV(argv[1], argv[2])) {
+            return 1;
+        }
+    }
+
     std::vector<DeliveryRequest<double>> regularDeliveries; ///< Vector to store regular deliveries
     std::vector<DeliveryRequest<double>> primeDeliveries; ///< Vector to store Prime deliveries
 
@@ -87,20 +38,27 @@ int main() {
     const std::string inputFile = "data/randomized_data_large.csv";
     loadDeliveriesFromCSV(inputFile, regularDeliveries, primeDeliveries);
 
+    // Weight of the load imbalance relative to the total distance
+    const double imbalanceWeight = 0.5;
+
     // Regular Customers Schedule
     ScheduleBalanced<double> regularSchedule;
-    regularSchedule.planRoutes(regularDeliveries);
-    regularSchedule.optimizeAllRoutes(depot);
-    regularSchedule.balanceWorkload(depot);
+    regularSchedule.setTravelCostModel(roadNetwork);
+    regularSchedule.planRoutes(regularDeliveries, depot, SeedingStrategy::RegretInsertion);
+    regularSchedule.optimizeJoint(depot, imbalanceWeight);
+    regularSchedule.optimizeStopOrder(depot);
     regularSchedule.exportData(depot, "results/regular_customers_balanced_large.csv");
+    regularSchedule.exportRoutes(depot, "results/regular_customers_routes_large.csv");
 
     // Combined Regular + Prime Customers Schedule
     ScheduleBalanced<double> combinedSchedule;
-    combinedSchedule.planRoutes(regularDeliveries);
-    combinedSchedule.planRoutes(primeDeliveries);
-    combinedSchedule.optimizeAllRoutes(depot);
-    combinedSchedule.balanceWorkload(depot);
+    combinedSchedule.setTravelCostModel(roadNetwork);
+    combinedSchedule.planRoutes(primeDeliveries, depot, SeedingStrategy::RegretInsertion);
+    combinedSchedule.planRoutes(regularDeliveries, depot, SeedingStrategy::RegretInsertion);
+    combinedSchedule.optimizeJoint(depot, imbalanceWeight);
+    combinedSchedule.optimizeStopOrder(depot);
     combinedSchedule.exportData(depot, "results/combined_customers_balanced_large.csv");
+    combinedSchedule.exportRoutes(depot, "results/combined_customers_routes_large.csv");
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "Address.hpp"
+#include "DeliveryLoader.hpp"
+#include "DeliveryRequest.hpp"
+#include "SchedulerService.hpp"
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static volatile std::sig_atomic_t stopRequested = 0; ///< Set by SIGINT or SIGTERM
+
+static void requestStop(int) { stopRequested = 1; }
+
+/**
+ * @brief Run the scheduler as a resident service on a Unix-domain socket.
+ *
+ * Usage: `scheduler_service [socket path] [orders.csv]`. The optional CSV is scheduled
+ * before the socket opens. The service runs until SIGINT or SIGTERM.
+ *
+ * @return Exit code (0 for success).
+ */
+int main(int argc, char* argv[]) {
+    const std::string socketPath = argc > 1 ? argv[1] : "/tmp/delivery_scheduler.sock";
+    Address<double> depot(0.0, 0.0); ///< The depot location
+
+    SchedulerService<double> service(depot);
+    if (argc > 2) {
+        std::vector<DeliveryRequest<double>> regularDeliveries, primeDeliveries;
+        loadDeliveriesFromCSV(argv[2], regularDeliveries, primeDeliveries);
+        primeDeliveries.insert(primeDeliveries.end(), regularDeliveries.begin(), regularDeliveries.end());
+        service.preload(primeDeliveries);
+        std::cout << "Preloaded " << primeDeliveries.size() << " orders" << std::endl;
+    }
+
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+    if (!service.start(socketPath)) return 1;
+    std::cout << "Listening on " << socketPath << std::endl;
+
+    while (!stopRequested) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    service.stop();
+
+    auto snapshot = service.getSnapshot();
+    std::cout << "Stopped after " << snapshot->version << " batches: " << snapshot->numOrders
+              << " orders, total distance " << snapshot->totalDistance << std::endl;
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include "RoadNetworkCost.hpp"
+#include "ScheduleBalanced.hpp"
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Build a small road network: a 3x3 grid with unit roads and the center road to (2,1) missing
+static std::shared_ptr<RoadNetworkCost<double>> makeGridNetwork() {
+    auto network = std::make_shared<RoadNetworkCost<double>>();
+    for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i < 3; ++i) {
+            network->addNode(i, j);
+        }
+    }
+    for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i < 3; ++i) {
+            int node = j * 3 + i;
+            if (i + 1 < 3 && node != 4) network->addEdge(node, node + 1, 1.0);
+            if (j + 1 < 3) network->addEdge(node, node + 3, 1.0);
+        }
+    }
+    network->build();
+    return network;
+}
+
+// Test hierarchy queries against known shortest paths
+TEST(ContractionHierarchyTest, QueryMatchesShortestPaths) {
+    ContractionHierarchy hierarchy(5);
+    hierarchy.addEdge(0, 1, 1.0);
+    hierarchy.addEdge(1, 2, 1.0);
+    hierarchy.addEdge(2, 3, 1.0);
+    hierarchy.addEdge(0, 3, 5.0);
+    hierarchy.build();
+
+    EXPECT_DOUBLE_EQ(hierarchy.query(0, 3), 3.0);
+    EXPECT_DOUBLE_EQ(hierarchy.query(3, 0), 3.0);
+    EXPECT_DOUBLE_EQ(hierarchy.query(1, 1), 0.0);
+    EXPECT_TRUE(std::isinf(hierarchy.query(0, 4))); // Node 4 is disconnected
+}
+
+// Test many-to-many matrix against point-to-point queries
+TEST(ContractionHierarchyTest, ManyToManyMatchesQueries) {
+    auto network = makeGridNetwork();
+    const auto& hierarchy = network->getHierarchy();
+    std::vector<int> nodes = {0, 2, 4, 5, 8};
+    auto matrix = hierarchy.manyToMany(nodes, nodes);
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        for (size_t j = 0; j < nodes.size(); ++j) {
+            EXPECT_DOUBLE_EQ(matrix[i][j], hierarchy.query(nodes[i], nodes[j]));
+        }
+    }
+}
+
+// Test road costs include detours and snapping offsets
+TEST(RoadNetworkCostTest, RoadCostAndSnapping) {
+    auto network = makeGridNetwork();
+    Address<double> center(1.0, 1.0);
+    Address<double> right(2.0, 1.0);
+
+    // The direct road is missing, so the trip detours through (1,0) or (1,2)
+    EXPECT_DOUBLE_EQ(network->cost(center, right), 3.0);
+    EXPECT_DOUBLE_EQ(network->cost(center, center), 0.0);
+
+    // An address off the graph snaps to its nearest node
+    auto [node, offset] = network->snap(Address<double>(2.1, 2.0));
+    EXPECT_EQ(node, 8);
+    EXPECT_NEAR(offset, 0.1, 1e-12);
+    EXPECT_NEAR(network->cost(Address<double>(0.0, 0.1), Address<double>(0.0, 1.0)), 0.1 + 1.0, 1e-12);
+}
+
+// Test the cost matrix and the cache
+TEST(RoadNetworkCostTest, CostMatrixAndCache) {
+    auto network = makeGridNetwork();
+    std::vector<Address<double>> points = {Address<double>(0.0, 0.0), Address<double>(1.0, 1.0), Address<double>(2.0, 1.0)};
+    auto matrix = network->costMatrix(points, points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        for (size_t j = 0; j < points.size(); ++j) {
+            EXPECT_DOUBLE_EQ(matrix[i][j], network->cost(points[i], points[j]));
+        }
+    }
+    EXPECT_GT(network->getCacheHits(), 0u);
+}
+
+// Test a straight road, whose collinear nodes span no area
+TEST(RoadNetworkCostTest, CollinearRoad) {
+    RoadNetworkCost<double> network;
+    for (int i = 0; i <= 100; ++i) {
+        network.addNode(i, 0.0);
+        if (i > 0) network.addEdge(i - 1, i, 1.0);
+    }
+    network.build();
+
+    auto [node, offset] = network.snap(Address<double>(42.4, 3.0));
+    EXPECT_EQ(node, 42);
+    EXPECT_NEAR(offset, std::hypot(0.4, 3.0), 1e-12);
+    EXPECT_DOUBLE_EQ(network.cost(Address<double>(0.0, 0.0), Address<double>(100.0, 0.0)), 100.0);
+}
+
+// Test that concurrent callers see the same costs as a single caller
+TEST(RoadNetworkCostTest, ConcurrentCosts) {
+    auto network = makeGridNetwork();
+    std::vector<Address<double>> points;
+    for (int i = 0; i < 20; ++i) points.emplace_back((i % 5) * 0.5, (i / 5) * 0.6);
+
+    std::vector<std::thread> workers;
+    std::vector<double> totals(4, 0.0);
+    for (size_t t = 0; t < totals.size(); ++t) {
+        workers.emplace_back([&, t] {
+            for (const auto& from : points) {
+                for (const auto& to : points) totals[t] += network->cost(from, to);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    double expected = 0.0;
+    for (const auto& from : points) {
+        for (const auto& to : points) expected += network->cost(from, to);
+    }
+    for (double total : totals) EXPECT_DOUBLE_EQ(total, expected);
+}
+
+// Test loading from CSV and round-tripping through the binary format
+TEST(RoadNetworkCostTest, LoadCSVAndBinary) {
+    {
+        std::ofstream nodes("test_road_nodes.csv");
+        nodes << "Id,X,Y\n0,0,0\n1,1,0\n2,1,1\n";
+        std::ofstream edges("test_road_edges.csv");
+        edges << "From,To,Cost\n0,1,2.5\n1,2,1.5\n";
+    }
+
+    RoadNetworkCost<double> network;
+    ASSERT_TRUE(network.loadFromCSV("test_road_nodes.csv", "test_road_edges.csv"));
+    EXPECT_DOUBLE_EQ(network.cost(Address<double>(0.0, 0.0), Address<double>(1.0, 1.0)), 4.0);
+
+    ASSERT_TRUE(network.saveBinary("test_road_graph.bin"));
+    RoadNetworkCost<double> loaded;
+    ASSERT_TRUE(loaded.loadFromBinary("test_road_graph.bin"));
+    EXPECT_EQ(loaded.getNumNodes(), 3);
+    EXPECT_DOUBLE_EQ(loaded.cost(Address<double>(1.0, 1.0), Address<double>(0.0, 0.0)), 4.0);
+
+    EXPECT_FALSE(loaded.loadFromCSV("missing_nodes.csv", "missing_edges.csv"));
+
+    std::remove("test_road_nodes.csv");
+    std::remove("test_road_edges.csv");
+    std::remove("test_road_graph.bin");
+}
+
+// Test schedules use the configured travel cost model
+TEST(RoadNetworkCostTest, ScheduleUsesCostModel) {
+    Address<double> depot(1.0, 1.0);
+    DeliveryRequest<double> request(Address<double>(2.0, 1.0), 1, 3, 3);
+
+    ScheduleBalanced<double> schedule;
+    schedule.planRoutes({request});
+    EXPECT_DOUBLE_EQ(schedule.calculateTotalDistance(depot), 2.0);
+
+    schedule.setTravelCostModel(makeGridNetwork());
+    EXPECT_DOUBLE_EQ(schedule.calculateTotalDistance(depot), 6.0);
+}
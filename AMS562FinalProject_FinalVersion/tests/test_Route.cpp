@@ -39,3 +39,99 @@ TEST(RouteTest, EmptyRoute) {
 
     EXPECT_DOUBLE_EQ(route.totalDistance(depot), 0.0);
 }
+
+// Test cheapest insertion and removal gain
+TEST(RouteTest, InsertionCostAndRemovalGain) {
+    Address<double> depot(0.0, 0.0);
+    DeliveryRequest<double> request1(Address<double>(3.0, 0.0), 1, 3, 7);
+    DeliveryRequest<double> request2(Address<double>(3.0, 4.0), 1, 3, 7);
+    DeliveryRequest<double> request3(Address<double>(3.0, 2.0), 1, 3, 7);
+
+    Route<double> route;
+    route.addDelivery(request1);
+    route.addDelivery(request2);
+
+    size_t position = 0;
+    double cost = route.insertionCost(request3, depot, defaultTravelCost<double>(), &position);
+    EXPECT_EQ(position, 1u); // Between (3,0) and (3,4), which costs nothing extra
+    EXPECT_NEAR(cost, 0.0, 1e-12);
+
+    double before = route.totalDistance(depot);
+    route.insertDelivery(request3, position);
+    EXPECT_NEAR(route.totalDistance(depot), before + cost, 1e-12);
+
+    double gain = route.removalGain(request2, depot);
+    before = route.totalDistance(depot);
+    route.removeDelivery(request2);
+    EXPECT_NEAR(route.totalDistance(depot), before - gain, 1e-12);
+
+    Route<double> empty;
+    EXPECT_DOUBLE_EQ(empty.insertionCost(request2, depot), 10.0);
+}
+
+// Test identical orders are removed one at a time
+TEST(RouteTest, RemoveDuplicateDelivery) {
+    DeliveryRequest<double> request(Address<double>(1.0, 1.0), 1, 3, 7);
+
+    Route<double> route;
+    route.addDelivery(request);
+    route.addDelivery(request);
+    route.removeDelivery(request);
+    EXPECT_EQ(route.getDeliveries().size(), 1);
+}
+
+// Test orders at the same address share one stop
+TEST(RouteTest, ConsolidateSameAddress) {
+    Address<double> depot(0.0, 0.0);
+    DeliveryRequest<double> request1(Address<double>(3.0, 4.0), 1, 3, 7);
+    DeliveryRequest<double> request2(Address<double>(3.0, 4.0), 2, 4, 8);
+    DeliveryRequest<double> request3(Address<double>(6.0, 8.0), 1, 3, 7);
+
+    Route<double> route;
+    route.addDelivery(request1);
+    route.addDelivery(request3);
+    EXPECT_DOUBLE_EQ(route.insertionCost(request2, depot), 0.0);
+    route.addDelivery(request2);
+
+    EXPECT_EQ(route.size(), 3u);
+    EXPECT_EQ(route.numStops(), 2u);
+    EXPECT_DOUBLE_EQ(route.totalDistance(depot), 20.0);
+
+    // Each order keeps its own window and comes back out next to its stop-mates
+    auto deliveries = route.getDeliveries();
+    ASSERT_EQ(deliveries.size(), 3u);
+    EXPECT_EQ(deliveries[1], request2);
+    EXPECT_EQ(deliveries[1].getLatestDeliveryDate(), 8);
+
+    // Removing one of two orders at a stop saves nothing; removing the last drops the stop
+    EXPECT_DOUBLE_EQ(route.removalGain(request1, depot), 0.0);
+    route.removeDelivery(request1);
+    EXPECT_EQ(route.numStops(), 2u);
+    EXPECT_DOUBLE_EQ(route.removalGain(request2, depot), 0.0);
+    route.removeDelivery(request2);
+    EXPECT_EQ(route.numStops(), 1u);
+    EXPECT_DOUBLE_EQ(route.totalDistance(depot), 20.0);
+}
+
+// Test merge tolerance for near-identical addresses and disabling merging
+TEST(RouteTest, MergeTolerance) {
+    DeliveryRequest<double> request1(Address<double>(1.0, 1.0), 1, 3, 7);
+    DeliveryRequest<double> request2(Address<double>(1.01, 1.0), 1, 3, 7);
+
+    Route<double> exact;
+    exact.addDelivery(request1);
+    exact.addDelivery(request2);
+    EXPECT_EQ(exact.numStops(), 2u);
+
+    Route<double> near(0.1);
+    near.addDelivery(request1);
+    near.addDelivery(request2);
+    EXPECT_EQ(near.numStops(), 1u);
+
+    Route<double> separate(-1.0);
+    separate.addDelivery(request1);
+    separate.addDelivery(request1);
+    EXPECT_EQ(separate.numStops(), 2u);
+    separate.removeDelivery(request1);
+    EXPECT_EQ(separate.size(), 1u);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "RouteExporter.hpp"
+#include "ScheduleBalanced.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Read all lines of a file
+static std::vector<std::string> readLines(const std::string& filename) {
+    std::ifstream inFile(filename);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(inFile, line)) lines.push_back(line);
+    return lines;
+}
+
+// Test the full stop sequence with cumulative distances
+TEST(RouteExporterTest, ExportsStopSequence) {
+    Address<double> depot(0.0, 0.0);
+    ScheduleBalanced<double> schedule;
+    schedule.planRoutes({DeliveryRequest<double>(Address<double>(3.0, 4.0), 1, 3, 7),
+                         DeliveryRequest<double>(Address<double>(3.0, 0.0), 1, 3, 7, false)});
+    ASSERT_TRUE(schedule.exportRoutes(depot, "test_routes.csv"));
+
+    auto lines = readLines("test_routes.csv");
+    ASSERT_EQ(lines.size(), 5u);
+    EXPECT_EQ(lines[0], "Day,Vehicle,Stop,X,Y,PlacementDate,EarliestDeliveryDate,LatestDeliveryDate,IsPrime,CumulativeDistance");
+    EXPECT_EQ(lines[1], "3,0,1,3,4,1,3,7,0,5");
+    EXPECT_EQ(lines[2], "3,0,2,3,0,1,3,7,0,9");
+    EXPECT_EQ(lines[3], "3,0,3,0,0,,,,,12");
+    EXPECT_EQ(lines[4], "Total,,2,,,,,,,12");
+    std::remove("test_routes.csv");
+}
+
+// Test consolidated stops expand back into one row per order under one stop number
+TEST(RouteExporterTest, ExpandsConsolidatedStops) {
+    Address<double> depot(0.0, 0.0);
+    Route<double> route;
+    route.addDelivery(DeliveryRequest<double>(Address<double>(3.0, 4.0), 1, 3, 7));
+    route.addDelivery(DeliveryRequest<double>(Address<double>(3.0, 0.0), 1, 3, 7));
+    route.addDelivery(DeliveryRequest<double>(Address<double>(3.0, 4.0), 2, 3, 5, false));
+    ASSERT_EQ(route.numStops(), 2u);
+
+    {
+        RouteExporter<double> exporter("test_consolidated.csv");
+        exporter.writeRoute(3, 0, route, depot);
+        EXPECT_EQ(exporter.getTotalStops(), 2u);
+        EXPECT_TRUE(exporter.close());
+    }
+
+    auto lines = readLines("test_consolidated.csv");
+    ASSERT_EQ(lines.size(), 6u);
+    EXPECT_EQ(lines[1], "3,0,1,3,4,1,3,7,0,5");
+    EXPECT_EQ(lines[2], "3,0,1,3,4,2,3,5,0,5");
+    EXPECT_EQ(lines[3], "3,0,2,3,0,1,3,7,0,9");
+    EXPECT_EQ(lines[4], "3,0,3,0,0,,,,,12");
+    std::remove("test_consolidated.csv");
+}
+
+// Test streaming days through small buffers
+TEST(RouteExporterTest, StreamsDaysThroughSmallBuffers) {
+    Address<double> depot(0.0, 0.0);
+    ScheduleBalanced<double> schedule;
+    std::vector<DeliveryRequest<double>> requests;
+    for (int i = 0; i < 300; ++i) {
+        requests.emplace_back(Address<double>((i % 41) / 10.0, (i % 7) / 10.0), i % 30, i % 30 + 1, i % 30 + 1);
+    }
+    schedule.planRoutes(requests);
+
+    {
+        RouteExporter<double> exporter("test_stream.csv", 512);
+        schedule.streamFinalizedDays(exporter, depot, 10);
+        schedule.streamFinalizedDays(exporter, depot, 10); // Already written days are skipped
+        schedule.streamFinalizedDays(exporter, depot, 100);
+        EXPECT_EQ(exporter.getTotalStops(), 300u);
+        EXPECT_NEAR(exporter.getTotalDistance(), schedule.calculateTotalDistance(depot), 1e-9);
+        EXPECT_TRUE(exporter.close());
+    }
+
+    auto lines = readLines("test_stream.csv");
+    ASSERT_EQ(lines.size(), 1u + 300u + 30u + 1u); // Header, stops, depot returns, total
+    EXPECT_EQ(lines.back().rfind("Total,,300,", 0), 0u);
+    std::remove("test_stream.csv");
+}
+
+// Test exporting to a path that cannot be opened
+TEST(RouteExporterTest, InvalidPath) {
+    ScheduleBalanced<double> schedule;
+    EXPECT_FALSE(schedule.exportRoutes(Address<double>(0.0, 0.0), "missing_directory/routes.csv"));
+}
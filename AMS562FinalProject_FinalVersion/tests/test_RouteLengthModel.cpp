@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "RouteLengthModel.hpp"
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <utility>
+#include <random>
+
+// Test the uncalibrated BHH estimate
+TEST(RouteLengthModelTest, DefaultEstimate) {
+    RouteLengthModel<double> model;
+
+    EXPECT_DOUBLE_EQ(model.estimate(0, 4.0), 0.0);
+    EXPECT_DOUBLE_EQ(model.estimate(4, 4.0), 0.7124 * 4.0);
+
+    // The area coefficient times the distance to the nearest stop, nothing at an existing stop
+    EXPECT_DOUBLE_EQ(model.insertionLength(2.0), 0.7124 * 2.0);
+    EXPECT_DOUBLE_EQ(model.insertionLength(0.0), 0.0);
+
+    // Only the area coefficient scales the distance
+    RouteLengthModel<double> fitted(1.5, 2.0, 3.0);
+    EXPECT_DOUBLE_EQ(fitted.insertionLength(2.0), 3.0);
+}
+
+// Test that calibrated estimates follow the true lengths of the days
+TEST(RouteLengthModelTest, CalibrateToRoutes) {
+    Address<double> depot(0.0, 0.0);
+    std::mt19937 rng(562);
+    std::uniform_real_distribution<double> coordinate(0.0, 4.0);
+
+    std::map<int, Route<double>> routes;
+    for (int day = 1; day <= 60; ++day) {
+        int orders = 2 + day % 15;
+        for (int i = 0; i < orders; ++i) {
+            routes[day].addDelivery(DeliveryRequest<double>(Address<double>(coordinate(rng), coordinate(rng)), 1, day, day));
+        }
+    }
+
+    RouteLengthModel<double> model;
+    ASSERT_TRUE(model.calibrate(routes, depot));
+    EXPECT_GT(model.getAreaCoefficient(), 0.0);
+
+    double relativeError = 0.0;
+    for (const auto& [day, route] : routes) {
+        double length = route.totalDistance(depot);
+        double estimate = model.estimate(route.numStops(), RouteLengthModel<double>::coveredArea(route, depot));
+        relativeError += std::abs(estimate - length) / length;
+    }
+    EXPECT_LT(relativeError / routes.size(), 0.15);
+}
+
+// Test that calibration needs enough days and keeps the previous coefficients otherwise
+TEST(RouteLengthModelTest, CalibrateTooFewRoutes) {
+    Address<double> depot(0.0, 0.0);
+    std::map<int, Route<double>> routes;
+    routes[1].addDelivery(DeliveryRequest<double>(Address<double>(1.0, 1.0), 1, 1, 1));
+
+    RouteLengthModel<double> model(1.0, 2.0, 3.0);
+    EXPECT_FALSE(model.calibrate(routes, depot));
+    EXPECT_DOUBLE_EQ(model.getAreaCoefficient(), 1.0);
+    EXPECT_DOUBLE_EQ(model.getStopCoefficient(), 2.0);
+    EXPECT_DOUBLE_EQ(model.getIntercept(), 3.0);
+}
+
+// Test writing a fitted model and reading it back
+TEST(RouteLengthModelTest, SaveAndLoad) {
+    const std::string filename = "test_route_length_model.txt";
+    RouteLengthModel<double> fitted(0.9, 1.25, -3.5);
+    ASSERT_TRUE(fitted.save(filename));
+
+    RouteLengthModel<double> model;
+    ASSERT_TRUE(model.load(filename));
+    EXPECT_DOUBLE_EQ(model.getAreaCoefficient(), 0.9);
+    EXPECT_DOUBLE_EQ(model.getStopCoefficient(), 1.25);
+    EXPECT_DOUBLE_EQ(model.getIntercept(), -3.5);
+    std::remove(filename.c_str());
+
+    EXPECT_FALSE(model.load("missing_route_length_model.txt"));
+    EXPECT_DOUBLE_EQ(model.getAreaCoefficient(), 0.9);
+}
+
+// Test the bounding-box area of a route and the depot
+TEST(RouteLengthModelTest, CoveredArea) {
+    Address<double> depot(1.0, 1.0);
+    Route<double> route;
+    EXPECT_DOUBLE_EQ(RouteLengthModel<double>::coveredArea(route, depot), 0.0);
+
+    route.addDelivery(DeliveryRequest<double>(Address<double>(3.0, 2.0), 1, 1, 1));
+    route.addDelivery(DeliveryRequest<double>(Address<double>(2.0, 4.0), 1, 1, 1));
+    EXPECT_DOUBLE_EQ(RouteLengthModel<double>::coveredArea(route, depot), 6.0);
+}
+
+// Test nearest-stop queries against a scan of all stops, for locations on and off the grid
+TEST(StopGridTest, NearestStop) {
+    StopGrid<double> grid(0.0, 0.0, 1.0, 4);
+    Route<double> route;
+    grid.assign(route);
+    EXPECT_EQ(grid.size(), 0u);
+    EXPECT_TRUE(std::isinf(grid.nearestDistance(Address<double>(1.0, 1.0))));
+
+    std::mt19937 rng(562);
+    std::uniform_real_distribution<double> coordinate(-1.0, 5.0);
+    for (int i = 0; i < 20; ++i) {
+        route.addDelivery(DeliveryRequest<double>(Address<double>(coordinate(rng), coordinate(rng)), 1, 1, 1));
+    }
+    route.addDelivery(DeliveryRequest<double>(Address<double>(2.5, 2.5), 1, 1, 1));
+    grid.assign(route);
+    EXPECT_EQ(grid.size(), route.numStops());
+    EXPECT_DOUBLE_EQ(grid.nearestDistance(Address<double>(2.5, 2.5)), 0.0);
+
+    for (int i = 0; i < 200; ++i) {
+        Address<double> location(2.0 * coordinate(rng) - 2.0, 2.0 * coordinate(rng) - 2.0);
+        double nearest = std::numeric_limits<double>::infinity();
+        route.forEachStop([&](const Route<double>::Stop& stop) {
+            nearest = std::min(nearest, stop.location.distanceTo(location));
+        });
+        EXPECT_NEAR(grid.nearestDistance(location), nearest, 1e-12);
+    }
+}
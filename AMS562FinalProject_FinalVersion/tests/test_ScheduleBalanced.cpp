@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "ScheduleBalanced.hpp"
+#include <cmath>
+#include <random>
 
 // Test planning and balancing deliveries
 TEST(ScheduleBalancedTest, PlanAndBalanceDeliveries) {
@@ -41,3 +43,246 @@ TEST(ScheduleBalancedTest, SingleDayDeliveries) {
 
     EXPECT_EQ(schedule.calculateTotalDistance(depot), depot.distanceTo(addr1) + addr1.distanceTo(addr2) + addr2.distanceTo(depot));
 }
+
+// Test that the joint optimizer moves deliveries to idle days when imbalance is weighted
+TEST(ScheduleBalancedTest, JointOptimizerSpreadsLoad) {
+    Address<double> depot(0.0, 0.0);
+
+    std::vector<DeliveryRequest<double>> requests = {
+        DeliveryRequest<double>(Address<double>(1.0, 0.0), 1, 1, 4),
+        DeliveryRequest<double>(Address<double>(0.0, 1.0), 1, 1, 4),
+        DeliveryRequest<double>(Address<double>(-1.0, 0.0), 1, 1, 4),
+        DeliveryRequest<double>(Address<double>(0.0, -1.0), 1, 1, 4),
+    };
+
+    ScheduleBalanced<double> schedule;
+    schedule.planRoutes(requests);
+    double imbalanceBefore = schedule.calculateLoadImbalance(depot);
+
+    schedule.optimizeJoint(depot, 1.0);
+    EXPECT_LT(schedule.calculateLoadImbalance(depot), imbalanceBefore);
+
+    size_t scheduled = 0;
+    for (const auto& [day, route] : schedule.getDailyRoutes()) scheduled += route.size();
+    EXPECT_EQ(scheduled, 4u);
+}
+
+// Test that without the imbalance weight the joint optimizer never increases the distance
+TEST(ScheduleBalancedTest, JointOptimizerDistanceOnly) {
+    Address<double> depot(0.0, 0.0);
+
+    std::vector<DeliveryRequest<double>> requests = {
+        DeliveryRequest<double>(Address<double>(5.0, 5.0), 1, 1, 2),
+        DeliveryRequest<double>(Address<double>(5.0, 5.1), 1, 2, 2),
+    };
+
+    ScheduleBalanced<double> schedule;
+    schedule.planRoutes(requests);
+    double before = schedule.calculateTotalDistance(depot);
+
+    schedule.optimizeJoint(depot, 0.0);
+    EXPECT_LT(schedule.calculateTotalDistance(depot), before);
+    EXPECT_EQ(schedule.getRoute(2).size(), 2u);
+}
+
+// Test that the max-day constraint rejects moves that overload a day
+TEST(ScheduleBalancedTest, JointOptimizerRespectsMaxDayDistance) {
+    Address<double> depot(0.0, 0.0);
+
+    std::vector<DeliveryRequest<double>> requests = {
+        DeliveryRequest<double>(Address<double>(5.0, 5.0), 1, 1, 2),
+        DeliveryRequest<double>(Address<double>(5.0, 5.1), 1, 2, 2),
+    };
+
+    ScheduleBalanced<double> schedule;
+    schedule.planRoutes(requests);
+    double singleTrip = schedule.getRoute(2).totalDistance(depot);
+
+    schedule.optimizeJoint(depot, 0.0, singleTrip + 0.01);
+    EXPECT_EQ(schedule.getRoute(1).size(), 1u);
+    EXPECT_EQ(schedule.getRoute(2).size(), 1u);
+}
+
+// Test that regret insertion keeps every delivery inside its window and spreads the load
+TEST(ScheduleBalancedTest, RegretInsertionSeeding) {
+    Address<double> depot(0.0, 0.0);
+
+    std::vector<DeliveryRequest<double>> requests;
+    for (int i = 0; i < 6; ++i) {
+        requests.emplace_back(Address<double>(1.0 + i, 1.0), 1, 1, 3);
+    }
+    requests.emplace_back(Address<double>(2.0, 2.0), 1, 2, 2, true);
+
+    ScheduleBalanced<double> schedule;
+    schedule.setSeedingParameters(0.5, 100.0);
+    schedule.planRoutes(requests, depot, SeedingStrategy::RegretInsertion);
+
+    size_t scheduled = 0;
+    for (const auto& [day, route] : schedule.getDailyRoutes()) {
+        route.forEachDelivery([&](const DeliveryRequest<double>& delivery) {
+            EXPECT_GE(day, delivery.getEarliestDeliveryDate());
+            EXPECT_LE(day, delivery.getLatestDeliveryDate());
+        });
+        EXPECT_LE(route.size(), 3u);
+        scheduled += route.size();
+    }
+    EXPECT_EQ(scheduled, requests.size());
+}
+
+// Test that nearby deliveries with overlapping windows are seeded on the same day
+TEST(ScheduleBalancedTest, LocationClusterSeeding) {
+    Address<double> depot(0.0, 0.0);
+
+    std::vector<DeliveryRequest<double>> requests = {
+        DeliveryRequest<double>(Address<double>(3.1, 3.1), 1, 1, 2),
+        DeliveryRequest<double>(Address<double>(3.2, 3.1), 1, 2, 3),
+        DeliveryRequest<double>(Address<double>(3.1, 3.2), 1, 1, 3),
+        DeliveryRequest<double>(Address<double>(0.1, 3.1), 1, 1, 3),
+        DeliveryRequest<double>(Address<double>(0.2, 3.1), 1, 1, 3),
+        DeliveryRequest<double>(Address<double>(0.1, 3.2), 1, 1, 3),
+        DeliveryRequest<double>(Address<double>(3.1, 0.1), 1, 3, 3),
+        DeliveryRequest<double>(Address<double>(3.2, 0.1), 1, 2, 3),
+        DeliveryRequest<double>(Address<double>(3.1, 0.2), 1, 1, 3),
+    };
+
+    ScheduleBalanced<double> schedule;
+    schedule.planRoutes(requests, depot, SeedingStrategy::LocationClusters);
+
+    // Tightest shared windows pick first; the flexible group takes the remaining day
+    for (int day = 1; day <= 3; ++day) {
+        ASSERT_EQ(schedule.getRoute(day).size(), 3u);
+    }
+    schedule.getRoute(2).forEachDelivery([](const DeliveryRequest<double>& delivery) {
+        EXPECT_GT(delivery.getAddress().getX(), 3.0);
+        EXPECT_GT(delivery.getAddress().getY(), 3.0);
+    });
+    schedule.getRoute(1).forEachDelivery([](const DeliveryRequest<double>& delivery) {
+        EXPECT_LT(delivery.getAddress().getX(), 1.0);
+    });
+}
+
+// Test that the earliest-day strategy matches the original planRoutes
+TEST(ScheduleBalancedTest, EarliestDaySeeding) {
+    Address<double> depot(0.0, 0.0);
+
+    std::vector<DeliveryRequest<double>> requests = {
+        DeliveryRequest<double>(Address<double>(1.0, 1.0), 1, 2, 5),
+        DeliveryRequest<double>(Address<double>(2.0, 2.0), 1, 4, 5),
+    };
+
+    ScheduleBalanced<double> schedule;
+    schedule.planRoutes(requests, depot, SeedingStrategy::EarliestDay);
+
+    EXPECT_EQ(schedule.getRoute(2).size(), 1u);
+    EXPECT_EQ(schedule.getRoute(4).size(), 1u);
+}
+
+// Test that screening by the surrogate keeps only the top-k days and never lengthens the schedule
+TEST(ScheduleBalancedTest, SurrogateScreening) {
+    Address<double> depot(0.0, 0.0);
+    std::mt19937 rng(562);
+    std::uniform_int_distribution<int> coordinate(0, 40);
+
+    std::vector<DeliveryRequest<double>> requests;
+    for (int day = 1; day <= 20; ++day) {
+        for (int i = 0; i < 8; ++i) {
+            requests.emplace_back(Address<double>(coordinate(rng) / 10.0, coordinate(rng) / 10.0), day, day, day + 4);
+        }
+    }
+    ScheduleBalanced<double> seeded;
+    seeded.planRoutes(requests);
+    double seededDistance = seeded.calculateTotalDistance(depot);
+
+    RouteLengthModel<double> model;
+    ASSERT_TRUE(model.calibrate(seeded.getDailyRoutes(), depot));
+
+    // Without an ambiguity margin only days with the same estimate as the kept one fall back
+    ScheduleBalanced<double> screened = seeded;
+    ScreeningStats stats;
+    stats.audit = true;
+    screened.optimizeAllRoutes(depot, model, 1, 0.0, &stats);
+
+    EXPECT_LT(screened.calculateTotalDistance(depot), seededDistance);
+    EXPECT_EQ(stats.exactEvaluations, stats.candidates / 4 + stats.fallbackEvaluations);
+    EXPECT_GT(stats.decisions, 0u);
+    EXPECT_EQ(stats.auditedDecisions, stats.decisions);
+    EXPECT_LE(stats.hits, stats.auditedDecisions);
+    EXPECT_GE(stats.maxRegret, 0.0);
+
+    // Days ranked close to the kept one are evaluated as well
+    ScheduleBalanced<double> fallback = seeded;
+    ScreeningStats margin;
+    fallback.optimizeAllRoutes(depot, model, 1, 0.25, &margin);
+    EXPECT_GT(margin.fallbackEvaluations, 0u);
+    EXPECT_EQ(margin.exactEvaluations, margin.candidates / 4 + margin.fallbackEvaluations);
+    EXPECT_LT(fallback.calculateTotalDistance(depot), seededDistance);
+
+    // A top-k covering the whole window screens nothing out and finds the full search's schedule
+    ScheduleBalanced<double> unscreened = seeded;
+    ScreeningStats all;
+    unscreened.optimizeAllRoutes(depot, model, 4, 0.25, &all);
+    EXPECT_EQ(all.exactEvaluations, all.candidates);
+    EXPECT_EQ(all.decisions, 0u);
+    EXPECT_TRUE(std::isnan(all.hitRate())); // Not measured without audit
+    ScheduleBalanced<double> full = seeded;
+    full.optimizeAllRoutes(depot);
+    EXPECT_DOUBLE_EQ(unscreened.calculateTotalDistance(depot), full.calculateTotalDistance(depot));
+}
+
+// Test the audited hit rate where the surrogate is known to pick the wrong day once
+TEST(ScheduleBalancedTest, SurrogateHitRate) {
+    Address<double> depot(0.0, 0.0);
+    DeliveryRequest<double> flexible(Address<double>(5.0, 5.0), 1, 1, 3);
+
+    // Day 2 has a stop 0.5 from (5, 5), so the surrogate ranks it cheapest, but joining it costs a detour.
+    // Day 3 visits (10, 10) only, and its route passes (5, 5) for free: the exact best day.
+    auto build = [&]() {
+        ScheduleBalanced<double> schedule;
+        schedule.getRoute(2).addDelivery(DeliveryRequest<double>(Address<double>(5.0, 5.5), 1, 2, 2));
+        schedule.getRoute(3).addDelivery(DeliveryRequest<double>(Address<double>(10.0, 10.0), 1, 3, 3));
+        schedule.getRoute(1).addDelivery(flexible);
+        return schedule;
+    };
+
+    RouteLengthModel<double> model;
+    ScheduleBalanced<double> schedule = build();
+    ScreeningStats stats;
+    stats.audit = true;
+    schedule.optimizeAllRoutes(depot, model, 1, 0.0, &stats);
+
+    // From day 1 the screen keeps day 2 while day 3 is best (miss). From day 2 it keeps day 3 (hit).
+    // On day 3 nothing improves, in the first pass and the final one (two hits).
+    EXPECT_EQ(schedule.getRoute(3).size(), 2u);
+    EXPECT_EQ(stats.auditedDecisions, 4u);
+    EXPECT_EQ(stats.hits, 3u);
+    EXPECT_DOUBLE_EQ(stats.hitRate(), 0.75);
+    EXPECT_GT(stats.maxRegret, 0.0);
+
+    // With a wide enough margin the fallback evaluates both days and moves straight to day 3
+    ScheduleBalanced<double> fallback = build();
+    ScreeningStats margin;
+    margin.audit = true;
+    fallback.optimizeAllRoutes(depot, model, 1, 20.0, &margin);
+    EXPECT_EQ(fallback.getRoute(3).size(), 2u);
+    EXPECT_EQ(fallback.getRoute(2).size(), 1u);
+    EXPECT_GT(margin.fallbackEvaluations, 0u);
+    EXPECT_EQ(margin.hits, margin.auditedDecisions);
+}
+
+// Test that evaluating moves that are not made leaves the routes untouched
+TEST(ScheduleBalancedTest, TrialMovesKeepRoutesUnchanged) {
+    Address<double> depot(0.0, 0.0);
+    ScheduleBalanced<double> schedule;
+    schedule.getRoute(1).addDelivery(DeliveryRequest<double>(Address<double>(1.0, 0.0), 1, 1, 3));
+    schedule.getRoute(3).addDelivery(DeliveryRequest<double>(Address<double>(-5.0, 0.0), 1, 3, 3));
+    uint64_t first = schedule.getRoute(1).getRevision(), third = schedule.getRoute(3).getRevision();
+
+    // Moving (1, 0) to day 3 saves exactly as much as it costs, and day 2 is a round trip
+    schedule.optimizeAllRoutes(depot);
+    RouteLengthModel<double> model;
+    schedule.optimizeAllRoutes(depot, model, 1);
+
+    EXPECT_EQ(schedule.getDailyRoutes().count(2), 0u);
+    EXPECT_EQ(schedule.getDailyRoutes().at(1).getRevision(), first);
+    EXPECT_EQ(schedule.getDailyRoutes().at(3).getRevision(), third);
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include "MpscQueue.hpp"
+#include "SchedulerService.hpp"
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+// Wait until the service has applied everything and reports the expected order count
+static bool waitForOrders(const SchedulerClient& client, uint64_t expected) {
+    for (int attempt = 0; attempt < 200; ++attempt) {
+        uint64_t version = 0, numOrders = 0;
+        double totalDistance = 0.0;
+        if (client.querySummary(version, numOrders, totalDistance) && numOrders == expected) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+// Send one order frame with raw dates and return the accepted flag of the reply (-1 on a protocol error)
+static int rawOrder(const std::string& socketPath, int32_t placement, int32_t earliest, int32_t latest, bool prime) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        if (fd >= 0) ::close(fd);
+        return -1;
+    }
+
+    WireBuffer request, reply;
+    request.put(static_cast<uint8_t>(MessageType::Order));
+    request.put(1.0);
+    request.put(1.0);
+    request.put(placement);
+    request.put(earliest);
+    request.put(latest);
+    request.put(static_cast<uint8_t>(prime));
+    uint8_t type = 0, accepted = 0;
+    bool ok = request.send(fd) && reply.receive(fd) && reply.get(type) && reply.get(accepted);
+    ::close(fd);
+    return ok && type == static_cast<uint8_t>(MessageType::Ack) ? accepted : -1;
+}
+
+// Test that every item from every producer arrives once and in per-producer order
+TEST(SchedulerServiceTest, MpscQueueManyProducers) {
+    MpscQueue<std::pair<int, int>> queue;
+    const int producers = 4, itemsPerProducer = 20000;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p] {
+            for (int i = 0; i < itemsPerProducer; ++i) queue.push({p, i});
+        });
+    }
+
+    std::vector<int> next(producers, 0);
+    int received = 0;
+    std::pair<int, int> item;
+    while (received < producers * itemsPerProducer) {
+        if (!queue.pop(item)) continue;
+        ASSERT_EQ(item.second, next[item.first]);
+        ++next[item.first];
+        ++received;
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_TRUE(queue.empty());
+}
+
+// Test orders, queries and cancellations over the socket
+TEST(SchedulerServiceTest, OrderQueryCancelRoundTrip) {
+    const std::string socketPath = "/tmp/test_scheduler_" + std::to_string(::getpid()) + ".sock";
+    SchedulerService<double> service(Address<double>(0.0, 0.0));
+    service.preload({DeliveryRequest<double>(Address<double>(1.0, 1.0), 1, 3, 3)});
+    ASSERT_TRUE(service.start(socketPath));
+
+    SchedulerClient client;
+    ASSERT_TRUE(client.connect(socketPath));
+
+    uint64_t id = 0;
+    ASSERT_TRUE(client.placeOrder(DeliveryRequest<double>(Address<double>(2.0, 2.0), 1, 5, 5), id));
+    EXPECT_EQ(id, 2u); // The preloaded order took the first id
+    ASSERT_TRUE(waitForOrders(client, 2));
+
+    std::vector<DeliveryRequest<double>> deliveries;
+    uint64_t version = 0;
+    ASSERT_TRUE(client.queryDay(5, deliveries, version));
+    ASSERT_EQ(deliveries.size(), 1u);
+    EXPECT_EQ(deliveries[0].getAddress().getX(), 2.0);
+    EXPECT_GT(version, 0u);
+
+    // Invalid windows are rejected at intake
+    uint64_t rejected = 0;
+    EXPECT_FALSE(client.placeOrder(DeliveryRequest<double>(Address<double>(2.0, 2.0), 1, 6, 5), rejected));
+
+    ASSERT_TRUE(client.cancelOrder(id));
+    ASSERT_TRUE(waitForOrders(client, 1));
+    ASSERT_TRUE(client.queryDay(5, deliveries, version));
+    EXPECT_TRUE(deliveries.empty());
+
+    service.stop();
+    EXPECT_NE(::access(socketPath.c_str(), F_OK), 0);
+}
+
+// Test that orders with negative days or unbounded windows are rejected over the socket
+TEST(SchedulerServiceTest, RejectsOversizedWindows) {
+    const std::string socketPath = "/tmp/test_scheduler_window_" + std::to_string(::getpid()) + ".sock";
+    SchedulerService<double> service(Address<double>(0.0, 0.0));
+    ASSERT_TRUE(service.start(socketPath));
+
+    SchedulerClient client;
+    ASSERT_TRUE(client.connect(socketPath));
+
+    const int maxWindow = SchedulerService<double>::maxWindowDays;
+    uint64_t id = 0;
+    EXPECT_FALSE(client.placeOrder(DeliveryRequest<double>(Address<double>(1.0, 1.0), 1, 1, INT_MAX), id));
+    EXPECT_FALSE(client.placeOrder(DeliveryRequest<double>(Address<double>(1.0, 1.0), 1, 2, 3 + maxWindow), id));
+    EXPECT_FALSE(client.placeOrder(DeliveryRequest<double>(Address<double>(1.0, 1.0), -1, -1, 3), id));
+    EXPECT_FALSE(client.placeOrder(DeliveryRequest<double>(Address<double>(1.0, 1.0), INT_MIN, 0, 3), id));
+
+    // Short windows near the end of the int range would overflow the day loops and the Prime window
+    EXPECT_FALSE(client.placeOrder(DeliveryRequest<double>(Address<double>(1.0, 1.0), 1, INT_MAX - 3, INT_MAX), id));
+    EXPECT_EQ(rawOrder(socketPath, INT_MAX, 1, 1, true), 0); // A DeliveryRequest cannot even be built for this one
+    const int lastDay = SchedulerService<double>::maxDay;
+    EXPECT_FALSE(client.placeOrder(DeliveryRequest<double>(Address<double>(1.0, 1.0), 1, lastDay, lastDay + 1), id));
+    EXPECT_EQ(id, 0u);
+
+    // The longest allowed window and the last allowed day are still scheduled
+    ASSERT_TRUE(client.placeOrder(DeliveryRequest<double>(Address<double>(1.0, 1.0), 1, 2, 2 + maxWindow), id));
+    EXPECT_EQ(id, 1u);
+    ASSERT_TRUE(client.placeOrder(DeliveryRequest<double>(Address<double>(2.0, 1.0), 1, lastDay - maxWindow, lastDay), id));
+    EXPECT_EQ(id, 2u);
+    EXPECT_TRUE(waitForOrders(client, 2));
+
+    service.stop();
+}
+
+// Test that snapshots share the days a batch did not touch
+TEST(SchedulerServiceTest, SnapshotsShareUnchangedDays) {
+    const std::string socketPath = "/tmp/test_scheduler_share_" + std::to_string(::getpid()) + ".sock";
+    SchedulerService<double> service(Address<double>(0.0, 0.0));
+    service.preload({DeliveryRequest<double>(Address<double>(1.0, 1.0), 1, 3, 3),
+                     DeliveryRequest<double>(Address<double>(2.0, 2.0), 1, 5, 5)});
+    auto before = service.getSnapshot();
+    ASSERT_TRUE(service.start(socketPath));
+
+    service.submitOrder(DeliveryRequest<double>(Address<double>(0.0, 3.0), 1, 5, 5));
+    auto after = service.getSnapshot();
+    for (int attempt = 0; attempt < 200 && after->numOrders < 3; ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        after = service.getSnapshot();
+    }
+    service.stop();
+
+    ASSERT_EQ(after->numOrders, 3u);
+    EXPECT_EQ(after->days.at(3), before->days.at(3)); // Same copy, not re-taken
+    EXPECT_NE(after->days.at(5), before->days.at(5));
+    EXPECT_EQ(after->days.at(5)->deliveries.size(), 2u);
+    EXPECT_NEAR(after->totalDistance, after->days.at(3)->distance + after->days.at(5)->distance, 1e-9);
+}
+
+// Test that the threads of disconnected clients are joined while the service runs
+TEST(SchedulerServiceTest, ReapsClosedConnections) {
+    const std::string socketPath = "/tmp/test_scheduler_reap_" + std::to_string(::getpid()) + ".sock";
+    SchedulerService<double> service(Address<double>(0.0, 0.0));
+    ASSERT_TRUE(service.start(socketPath));
+
+    auto waitForConnections = [&service](size_t expected) {
+        for (int attempt = 0; attempt < 200; ++attempt) {
+            if (service.getNumConnections() == expected) return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    };
+
+    std::vector<SchedulerClient> clients(8);
+    for (auto& client : clients) {
+        ASSERT_TRUE(client.connect(socketPath));
+        uint64_t version = 0, numOrders = 0;
+        double totalDistance = 0.0;
+        ASSERT_TRUE(client.querySummary(version, numOrders, totalDistance));
+    }
+    EXPECT_TRUE(waitForConnections(8));
+
+    for (auto& client : clients) client.disconnect();
+    EXPECT_TRUE(waitForConnections(0));
+    service.stop();
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "Route.hpp"
+#include "RoadNetworkCost.hpp"
+#include "TourSolver.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Tour cost by brute force over every visiting order
+static double bruteForceCost(const Address<double>& depot, const std::vector<Address<double>>& stops) {
+    std::vector<size_t> order(stops.size());
+    std::iota(order.begin(), order.end(), 0);
+    double best = std::numeric_limits<double>::infinity();
+    do {
+        double cost = 0.0;
+        Address<double> current = depot;
+        for (size_t i : order) {
+            cost += current.distanceTo(stops[i]);
+            current = stops[i];
+        }
+        best = std::min(best, cost + current.distanceTo(depot));
+    } while (std::next_permutation(order.begin(), order.end()));
+    return best;
+}
+
+// Test the exact solver against brute force
+TEST(TourSolverTest, ExactMatchesBruteForce) {
+    std::mt19937 rng(562);
+    std::uniform_real_distribution<double> coordinate(0.0, 4.0);
+    Address<double> depot(0.0, 0.0);
+    TourSolver<double> solver;
+
+    for (int trial = 0; trial < 5; ++trial) {
+        std::vector<Address<double>> stops;
+        for (int i = 0; i < 8; ++i) stops.emplace_back(coordinate(rng), coordinate(rng));
+
+        auto tour = solver.solveExact(depot, stops);
+        EXPECT_NEAR(tour.cost, bruteForceCost(depot, stops), 1e-9);
+
+        std::vector<size_t> visited = tour.order;
+        std::sort(visited.begin(), visited.end());
+        for (size_t i = 0; i < stops.size(); ++i) EXPECT_EQ(visited[i], i);
+
+        EXPECT_LE(tour.cost, solver.improveTour(depot, stops).cost + 1e-9);
+    }
+}
+
+// Test that the same stop set in another order is served from the cache
+TEST(TourSolverTest, CachesByStopSet) {
+    Address<double> depot(0.0, 0.0);
+    std::vector<Address<double>> stops = {Address<double>(1.0, 3.0), Address<double>(3.0, 1.0),
+                                          Address<double>(3.0, 3.0), Address<double>(1.0, 1.0)};
+    TourSolver<double> solver;
+
+    auto first = solver.solveExact(depot, stops);
+    std::reverse(stops.begin(), stops.end());
+    auto second = solver.solveExact(depot, stops);
+
+    EXPECT_EQ(solver.getCacheMisses(), 1u);
+    EXPECT_EQ(solver.getCacheHits(), 1u);
+    EXPECT_DOUBLE_EQ(first.cost, second.cost);
+
+    // The cached order refers to the stops as passed in
+    double cost = 0.0;
+    Address<double> current = depot;
+    for (size_t i : second.order) {
+        cost += current.distanceTo(stops[i]);
+        current = stops[i];
+    }
+    EXPECT_NEAR(cost + current.distanceTo(depot), second.cost, 1e-9);
+}
+
+// Test the route dispatcher for exact and heuristic ordering
+TEST(TourSolverTest, RouteDispatch) {
+    Address<double> depot(0.0, 0.0);
+    Route<double> route;
+    route.addDelivery(DeliveryRequest<double>(Address<double>(3.0, 3.0), 1, 3, 7));
+    route.addDelivery(DeliveryRequest<double>(Address<double>(1.0, 0.0), 1, 3, 7));
+    route.addDelivery(DeliveryRequest<double>(Address<double>(3.0, 0.0), 1, 3, 7));
+    route.addDelivery(DeliveryRequest<double>(Address<double>(1.0, 3.0), 1, 3, 7));
+    Route<double> heuristic = route;
+
+    TourSolver<double> exactSolver(12);
+    double before = route.totalDistance(depot);
+    double after = route.optimizeStopOrder(depot, defaultTravelCost<double>(), exactSolver);
+    EXPECT_LT(after, before);
+    EXPECT_NEAR(route.totalDistance(depot), after, 1e-9);
+    EXPECT_EQ(route.size(), 4u);
+    EXPECT_EQ(exactSolver.getCacheMisses(), 1u);
+
+    TourSolver<double> heuristicSolver(2);
+    EXPECT_LE(heuristic.optimizeStopOrder(depot, defaultTravelCost<double>(), heuristicSolver), before);
+    EXPECT_EQ(heuristicSolver.getCacheMisses(), 0u);
+}
+
+// Test that rebuilding a road network invalidates its cached tours
+TEST(TourSolverTest, RebuiltModelIsNotServedStaleTours) {
+    // A ring road around a 2 x 2 square, without the shortcuts through the center
+    RoadNetworkCost<double> network;
+    for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i < 3; ++i) network.addNode(i, j);
+    }
+    for (auto [from, to] : {std::pair<int, int>{0, 1}, {1, 2}, {2, 5}, {5, 8}, {8, 7}, {7, 6}, {6, 3}, {3, 0}}) {
+        network.addEdge(from, to, 1.0);
+    }
+    network.build();
+
+    Address<double> depot(0.0, 0.0);
+    std::vector<Address<double>> stops = {Address<double>(1.0, 1.0), Address<double>(2.0, 1.0), Address<double>(1.0, 2.0)};
+    TourSolver<double> solver;
+    double ringCost = solver.solveExact(depot, stops, network).cost;
+
+    // Open the center and rebuild: the same object now answers differently
+    network.addEdge(1, 4, 1.0);
+    network.addEdge(4, 5, 1.0);
+    network.addEdge(4, 7, 1.0);
+    network.build();
+
+    TourSolver<double> fresh;
+    double rebuiltCost = solver.solveExact(depot, stops, network).cost;
+    EXPECT_DOUBLE_EQ(rebuiltCost, fresh.solveExact(depot, stops, network).cost);
+    EXPECT_NE(rebuiltCost, ringCost);
+    EXPECT_EQ(solver.getCacheHits(), 0u);
+
+    // The route reports its measured length after reordering
+    Route<double> route;
+    for (const auto& stop : stops) route.addDelivery(DeliveryRequest<double>(stop, 1, 1, 1));
+    double reordered = route.optimizeStopOrder(depot, network, solver);
+    EXPECT_DOUBLE_EQ(reordered, route.totalDistance(depot, network));
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "ZonedSchedule.hpp"
+#include <map>
+#include <tuple>
+
+// Generate deliveries on a grid around the depot
+static std::vector<DeliveryRequest<double>> makeDeliveries(int count) {
+    std::vector<DeliveryRequest<double>> deliveries;
+    for (int i = 0; i < count; ++i) {
+        Address<double> addr((i * 7 % 41) / 10.0, (i * 13 % 41) / 10.0);
+        int placementDate = 1 + i % 20;
+        deliveries.emplace_back(addr, placementDate, placementDate + 3, placementDate + 7, i % 9 == 0);
+    }
+    return deliveries;
+}
+
+// Count how often every delivery occurs in a list
+static std::map<std::tuple<double, double, int, bool>, int> countDeliveries(const std::vector<DeliveryRequest<double>>& deliveries) {
+    std::map<std::tuple<double, double, int, bool>, int> counts;
+    for (const auto& delivery : deliveries) {
+        ++counts[{delivery.getAddress().getX(), delivery.getAddress().getY(), delivery.getPlacementDate(), delivery.getIsPrime()}];
+    }
+    return counts;
+}
+
+// Test both partitioning methods respect the zone size bound
+TEST(ZonedScheduleTest, PartitionRespectsZoneSize) {
+    Address<double> depot(0.0, 0.0);
+    auto deliveries = makeDeliveries(230);
+
+    for (auto method : {ZoningMethod::Sectors, ZoningMethod::KMeans}) {
+        ZonedSchedule<double> schedule(method, 50);
+        auto zoneOf = schedule.partition(deliveries, depot);
+        ASSERT_EQ(zoneOf.size(), deliveries.size());
+
+        std::map<size_t, int> sizes;
+        for (size_t zone : zoneOf) ++sizes[zone];
+        EXPECT_EQ(sizes.size(), 5u);
+        for (const auto& [zone, size] : sizes) {
+            EXPECT_LE(size, 50);
+        }
+    }
+}
+
+// Test solving keeps every delivery exactly once, on a day within its window
+TEST(ZonedScheduleTest, SolveKeepsAllDeliveries) {
+    Address<double> depot(0.0, 0.0);
+    auto deliveries = makeDeliveries(200);
+
+    ZonedSchedule<double> schedule(ZoningMethod::KMeans, 40, 2);
+    schedule.solve(deliveries, depot);
+
+    std::vector<DeliveryRequest<double>> scheduled;
+    for (const auto& [day, route] : schedule.getSchedule().getDailyRoutes()) {
+        for (const auto& delivery : route.getDeliveries()) {
+            EXPECT_TRUE(delivery.isWithinDeliveryWindow(day));
+            scheduled.push_back(delivery);
+        }
+    }
+    EXPECT_EQ(countDeliveries(scheduled), countDeliveries(deliveries));
+    EXPECT_GT(schedule.calculateTotalDistance(depot), 0.0);
+}
+
+// Test that the merge tolerance reaches the zone schedules
+TEST(ZonedScheduleTest, ForwardsStopMergeTolerance) {
+    Address<double> depot(0.0, 0.0);
+    std::vector<DeliveryRequest<double>> deliveries = {
+        DeliveryRequest<double>(Address<double>(1.0, 1.0), 1, 2, 2),
+        DeliveryRequest<double>(Address<double>(1.04, 1.02), 1, 2, 2),
+    };
+
+    ZonedSchedule<double> schedule(ZoningMethod::Sectors, 500, 1);
+    schedule.setStopMergeTolerance(0.5);
+    schedule.solve(deliveries, depot);
+
+    ASSERT_EQ(schedule.getZones().size(), 1u);
+    const auto& route = schedule.getZones()[0].getDailyRoutes().at(2);
+    EXPECT_EQ(route.size(), 2u);
+    EXPECT_EQ(route.numStops(), 1u);
+    EXPECT_EQ(schedule.getSchedule().getDailyRoutes().at(2).numStops(), 1u);
+}
+
+// Test boundary repair never lengthens the zone routes
+TEST(ZonedScheduleTest, RepairDoesNotIncreaseDistance) {
+    Address<double> depot(0.0, 0.0);
+    auto deliveries = makeDeliveries(150);
+
+    ZonedSchedule<double> schedule(ZoningMethod::Sectors, 30);
+    schedule.setZoneSolver([](ScheduleBalanced<double>&, const Address<double>&) {});
+    schedule.solve(deliveries, depot);
+
+    double before = schedule.calculateZoneDistance(depot);
+    schedule.repairBoundaries(depot);
+    EXPECT_LE(schedule.calculateZoneDistance(depot), before + 1e-9);
+    EXPECT_EQ(schedule.repairBoundaries(depot), 0); // Already converged
+}
+
+// Test that stitching serves every day with one route that is no longer than the zone routes together
+TEST(ZonedScheduleTest, StitchesOneRoutePerDay) {
+    Address<double> depot(0.0, 0.0);
+    auto deliveries = makeDeliveries(200);
+
+    ZonedSchedule<double> schedule(ZoningMethod::KMeans, 40, 2);
+    schedule.solve(deliveries, depot);
+    ASSERT_GT(schedule.getZones().size(), 1u);
+
+    std::vector<size_t> zoneOrder(schedule.getZones().size());
+    for (size_t z = 0; z < zoneOrder.size(); ++z) zoneOrder[z] = z;
+    schedule.stitchZones(zoneOrder);
+
+    std::map<int, size_t> zoneOrders;
+    for (const auto& zone : schedule.getZones()) {
+        for (const auto& [day, route] : zone.getDailyRoutes()) zoneOrders[day] += route.size();
+    }
+    for (const auto& [day, route] : schedule.getSchedule().getDailyRoutes()) {
+        EXPECT_EQ(route.size(), zoneOrders[day]);
+    }
+    EXPECT_LE(schedule.calculateTotalDistance(depot), schedule.calculateZoneDistance(depot) + 1e-9);
+}
+
+// Test an empty schedule
+TEST(ZonedScheduleTest, EmptySchedule) {
+    Address<double> depot(0.0, 0.0);
+    ZonedSchedule<double> schedule;
+    schedule.solve({}, depot);
+    EXPECT_TRUE(schedule.getZones().empty());
+    EXPECT_EQ(schedule.calculateTotalDistance(depot), 0.0);
+}